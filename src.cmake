@@ -18,6 +18,7 @@ set(CGAMELIST
     ${GAMELOGIC_DIR}/cgame/cg_animation.cpp
     ${GAMELOGIC_DIR}/cgame/cg_animmapobj.cpp
     ${GAMELOGIC_DIR}/cgame/cg_api.cpp
+    ${GAMELOGIC_DIR}/cgame/cg_assetcache.cpp
     ${GAMELOGIC_DIR}/cgame/cg_attachment.cpp
     ${GAMELOGIC_DIR}/cgame/cg_beacon.cpp
     ${GAMELOGIC_DIR}/cgame/cg_buildable.cpp
@@ -133,6 +134,10 @@ set(SGAMELIST
     ${GAMELOGIC_DIR}/sgame/sg_momentum.cpp
     ${GAMELOGIC_DIR}/sgame/sg_namelog.cpp
     ${GAMELOGIC_DIR}/sgame/sg_physics.cpp
+    ${GAMELOGIC_DIR}/sgame/sg_pmovereplay.cpp
+    ${GAMELOGIC_DIR}/sgame/sg_pmovereplay.h
+    ${GAMELOGIC_DIR}/sgame/sg_profiler.cpp
+    ${GAMELOGIC_DIR}/sgame/sg_profiler.h
     ${GAMELOGIC_DIR}/sgame/sg_public.h
     ${GAMELOGIC_DIR}/sgame/sg_session.cpp
     ${GAMELOGIC_DIR}/sgame/sg_spawn.cpp
@@ -149,6 +154,8 @@ set(SGAMELIST
     ${GAMELOGIC_DIR}/sgame/sg_spawn_shared.cpp
     ${GAMELOGIC_DIR}/sgame/sg_struct.h
     ${GAMELOGIC_DIR}/sgame/sg_svcmds.cpp
+    ${GAMELOGIC_DIR}/sgame/sg_targets.cpp
+    ${GAMELOGIC_DIR}/sgame/sg_targets.h
     ${GAMELOGIC_DIR}/sgame/sg_team.cpp
     ${GAMELOGIC_DIR}/sgame/sg_trapcalls.h
     ${GAMELOGIC_DIR}/sgame/sg_typedef.h
@@ -175,6 +182,7 @@ set(SGAMELIST
     ${GAMELOGIC_DIR}/sgame/components/IgnitableComponent.cpp
     ${GAMELOGIC_DIR}/sgame/components/KnockbackComponent.cpp
     ${GAMELOGIC_DIR}/sgame/components/LeechComponent.cpp
+    ${GAMELOGIC_DIR}/sgame/components/LocationComponent.cpp
     ${GAMELOGIC_DIR}/sgame/components/MainBuildableComponent.cpp
     ${GAMELOGIC_DIR}/sgame/components/MedipadComponent.cpp
     ${GAMELOGIC_DIR}/sgame/components/MGTurretComponent.cpp
@@ -0,0 +1,256 @@
+/*
+===========================================================================
+
+Unvanquished GPL Source Code
+Copyright (C) 2026 Unvanquished Developers
+
+This file is part of the Unvanquished GPL Source Code (Unvanquished Source Code).
+
+Unvanquished is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Unvanquished is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Unvanquished.  If not, see <http://www.gnu.org/licenses/>.
+
+===========================================================================
+*/
+
+// cg_assetcache.cpp -- binary cache of parsed script files
+//
+// Loaders that turn a directory of scripts into base structures can save those
+// structures here after parsing, and load them instead of parsing on the next
+// start. A cache is keyed by the version of the game, the list of script
+// files, the pak every one of them comes from with its checksum, their
+// timestamps and the layout of the cached structures, so any change falls back
+// to parsing the text again.
+
+#include "cg_local.h"
+
+#define ASSET_CACHE_MAGIC   "CGAC"
+#define ASSET_CACHE_VERSION 1
+
+struct assetCacheHeader_t
+{
+	char     magic[ 4 ];
+	int      version;
+	uint64_t key;
+	uint32_t length;   // of the data following the header
+	uint32_t checksum; // of that data, to reject files that were cut short
+};
+
+static void CG_HashBytes( uint64_t &hash, const void *data, size_t len )
+{
+	const byte *bytes = ( const byte * ) data;
+
+	// FNV-1a
+	for ( size_t i = 0; i < len; i++ )
+	{
+		hash ^= bytes[ i ];
+		hash *= 0x100000001b3ULL;
+	}
+}
+
+static void CG_HashString( uint64_t &hash, Str::StringRef string )
+{
+	// include the terminator so that consecutive strings can't run into each other
+	CG_HashBytes( hash, string.c_str(), string.size() + 1 );
+}
+
+static uint32_t CG_AssetCacheChecksum( const std::vector<byte> &data )
+{
+	uint64_t hash = 0xcbf29ce484222325ULL;
+
+	CG_HashBytes( hash, data.data(), data.size() );
+
+	return ( uint32_t )( hash ^ ( hash >> 32 ) );
+}
+
+static std::string CG_AssetCachePath( const char *name )
+{
+	return Str::Format( "cache/%s.cache", name );
+}
+
+/*
+===============
+CG_AssetCacheKey
+
+Computes the key of a cache built from files in dir, given as a list of
+numFiles names in the format of trap_FS_GetFileList. The values of layout
+should change whenever the cached structures do, their sizes and the number
+of values of the enums they hold are a good start.
+===============
+*/
+uint64_t CG_AssetCacheKey( const char *dir, const char *fileList, int numFiles, std::initializer_list<size_t> layout )
+{
+	uint64_t    hash = 0xcbf29ce484222325ULL;
+	int         version = ASSET_CACHE_VERSION;
+	const char *filePtr = fileList;
+
+	CG_HashBytes( hash, &version, sizeof( version ) );
+
+	// the parsers may change without the structures doing so
+	CG_HashString( hash, PRODUCT_VERSION );
+	CG_HashString( hash, GAME_VERSION );
+
+	for ( size_t value : layout )
+	{
+		uint64_t value64 = value;
+
+		CG_HashBytes( hash, &value64, sizeof( value64 ) );
+	}
+
+	for ( int i = 0; i < numFiles; i++, filePtr += strlen( filePtr ) + 1 )
+	{
+		std::string path = Str::Format( "%s/%s", dir, filePtr );
+
+		CG_HashString( hash, path );
+
+		const FS::PakInfo *pak = FS::PakPath::LocateFile( path );
+
+		if ( pak )
+		{
+			uint32_t checksum = pak->realChecksum ? *pak->realChecksum : 0;
+
+			CG_HashString( hash, pak->name );
+			CG_HashString( hash, pak->version );
+			CG_HashBytes( hash, &checksum, sizeof( checksum ) );
+		}
+
+		std::error_code err;
+		int64_t mtime = FS::PakPath::FileTimestamp( path, err ).time_since_epoch().count();
+
+		if ( err )
+		{
+			mtime = 0;
+		}
+
+		CG_HashBytes( hash, &mtime, sizeof( mtime ) );
+	}
+
+	return hash;
+}
+
+/*
+===============
+CG_LoadAssetCache
+
+Reads the data of the named cache if there is one for the given key.
+===============
+*/
+bool CG_LoadAssetCache( const char *name, uint64_t key, std::vector<byte> &data )
+{
+	fileHandle_t       f;
+	assetCacheHeader_t header;
+
+	if ( !cg_assetCache.integer )
+	{
+		return false;
+	}
+
+	int len = trap_FS_FOpenFile( CG_AssetCachePath( name ).c_str(), &f, fsMode_t::FS_READ );
+
+	if ( !f )
+	{
+		return false;
+	}
+
+	if ( len < ( int ) sizeof( header ) )
+	{
+		trap_FS_FCloseFile( f );
+		return false;
+	}
+
+	trap_FS_Read( &header, sizeof( header ), f );
+
+	if ( memcmp( header.magic, ASSET_CACHE_MAGIC, sizeof( header.magic ) ) ||
+	     header.version != ASSET_CACHE_VERSION || header.key != key ||
+	     ( int ) header.length != len - ( int ) sizeof( header ) )
+	{
+		trap_FS_FCloseFile( f );
+		Log::Debug( "asset cache %s is out of date", name );
+		return false;
+	}
+
+	data.resize( header.length );
+	trap_FS_Read( data.data(), header.length, f );
+	trap_FS_FCloseFile( f );
+
+	if ( CG_AssetCacheChecksum( data ) != header.checksum )
+	{
+		Log::Warn( "asset cache %s is corrupt", name );
+		data.clear();
+		return false;
+	}
+
+	Log::Debug( "loaded %s from the asset cache", name );
+	return true;
+}
+
+/*
+===============
+CG_SaveAssetCache
+===============
+*/
+void CG_SaveAssetCache( const char *name, uint64_t key, const std::vector<byte> &data )
+{
+	fileHandle_t       f;
+	assetCacheHeader_t header{};
+
+	if ( !cg_assetCache.integer )
+	{
+		return;
+	}
+
+	trap_FS_FOpenFile( CG_AssetCachePath( name ).c_str(), &f, fsMode_t::FS_WRITE );
+
+	if ( !f )
+	{
+		Log::Warn( "couldn't write asset cache %s", name );
+		return;
+	}
+
+	memcpy( header.magic, ASSET_CACHE_MAGIC, sizeof( header.magic ) );
+	header.version = ASSET_CACHE_VERSION;
+	header.key = key;
+	header.length = data.size();
+	header.checksum = CG_AssetCacheChecksum( data );
+
+	trap_FS_Write( &header, sizeof( header ), f );
+	trap_FS_Write( data.data(), data.size(), f );
+	trap_FS_FCloseFile( f );
+}
+
+void CG_AssetCacheWrite( std::vector<byte> &data, const void *src, size_t len )
+{
+	const byte *bytes = ( const byte * ) src;
+
+	data.insert( data.end(), bytes, bytes + len );
+}
+
+/*
+===============
+CG_AssetCacheRead
+
+Copies the next len bytes of a loaded cache to dest, returns false if the
+cache is too short.
+===============
+*/
+bool CG_AssetCacheRead( const std::vector<byte> &data, size_t &pos, void *dest, size_t len )
+{
+	if ( len > data.size() - pos )
+	{
+		return false;
+	}
+
+	memcpy( dest, data.data() + pos, len );
+	pos += len;
+
+	return true;
+}
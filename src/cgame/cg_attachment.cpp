@@ -101,7 +101,7 @@ bool CG_AttachmentPoint( attachment_t *a, vec3_t v )
 			}
 			else
 			{
-				VectorCopy( a->particle->origin, v );
+				CG_ParticleOrigin( a->particle, v );
 			}
 
 			break;
@@ -176,7 +176,7 @@ bool CG_AttachmentDir( attachment_t *a, vec3_t v )
 			}
 			else
 			{
-				VectorCopy( a->particle->velocity, v );
+				CG_ParticleVelocity( a->particle, v );
 			}
 
 			break;
@@ -257,7 +257,7 @@ bool CG_AttachmentVelocity( attachment_t *a, vec3_t v )
 
 	if ( a->particleValid && a->particle->valid )
 	{
-		VectorCopy( a->particle->velocity, v );
+		CG_ParticleVelocity( a->particle, v );
 		return true;
 	}
 	else if ( a->centValid )
@@ -645,6 +645,7 @@ static void CG_Portal( centity_t *cent )
 
 	// add to refresh list
 	trap_R_AddRefEntityToScene( &ent );
+	cg.portalInScene = true;
 }
 
 //============================================================================
@@ -1274,6 +1275,8 @@ void CG_AddPacketEntities()
 	centity_t     *cent;
 	playerState_t *ps;
 
+	cg.portalInScene = false;
+
 	// set cg.frameInterpolation
 	if ( cg.nextSnap )
 	{
@@ -29,6 +29,7 @@ Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
 
 #include <memory>
 #include <vector>
+#include <unordered_map>
 
 #include "common/KeyIdentification.h"
 #include "engine/qcommon/q_shared.h"
@@ -206,7 +207,7 @@ struct attachment_t
 
 #define MAX_PARTICLE_SYSTEMS      48
 #define MAX_PARTICLE_EJECTORS     (MAX_PARTICLE_SYSTEMS * MAX_EJECTORS_PER_SYSTEM)
-#define MAX_PARTICLES             (MAX_PARTICLE_EJECTORS * 5)
+#define PARTICLE_BLOCK_SIZE       1024 // particles are added in blocks up to cg_maxParticles
 
 #define PARTICLES_INFINITE        -1
 #define PARTICLES_SAME_AS_INITIAL -2
@@ -322,6 +323,7 @@ struct baseParticle_t
 	qhandle_t   shaders[ MAX_PS_SHADER_FRAMES ];
 	int         numFrames;
 	float       framerate;
+	bool        timedShaders; // a frame's shader animates on its own, so it can't be batched
 
 	char        modelNames[ MAX_PS_MODELS ][ MAX_QPATH ];
 	qhandle_t   models[ MAX_PS_MODELS ];
@@ -390,6 +392,8 @@ struct particleEjector_t
 
 	int              nextEjectionTime;
 
+	int              numParticles; // alive ones
+
 	bool         valid;
 };
 
@@ -409,14 +413,13 @@ struct particle_t
 	int               bounceSoundCount;
 	bool          atRest;
 
-	vec3_t            origin;
-	vec3_t            velocity;
+	// the origin, velocity and evaluation time are kept in arrays next to the
+	// particle, see CG_ParticleOrigin and CG_ParticleVelocity
+	int               slot;
 
 	pMoveType_t       accMoveType;
 	pMoveValues_t     accMoveValues;
 
-	int               lastEvalTime;
-
 	pLerpValues_t     radius;
 	pLerpValues_t     alpha;
 	pLerpValues_t     rotation;
@@ -431,8 +434,6 @@ struct particle_t
 
 	bool          valid;
 	int               frameWhenInvalidated;
-
-	int               sortKey;
 };
 
 //======================================================================
@@ -1103,6 +1104,7 @@ struct cg_t
 	bool mapRestart; // set on a map restart to set back the weapon
 
 	bool renderingThirdPerson; // during deaths, chasecams, etc
+	bool portalInScene; // the renderer may draw the scene again from the view of a portal or mirror
 
 	// prediction state
 	bool      hyperspace; // true if prediction has hit a trigger_teleport
@@ -1148,6 +1150,8 @@ struct cg_t
 	int      numScores;
 	int      teamScores[ 2 ];
 	score_t  scores[ MAX_CLIENTS ];
+	bool scoresReceived; // a whole scoreboard arrived, updates to it can be applied
+	bool scoresRequested; // a whole scoreboard was asked for and hasn't arrived yet
 	bool showScores;
 	char     killerName[ MAX_NAME_LENGTH ];
 	char     spectatorList[ MAX_STRING_CHARS ]; // list of names
@@ -1774,6 +1778,7 @@ extern  vmCvar_t            cg_debugEvents;
 extern  vmCvar_t            cg_errorDecay;
 extern  vmCvar_t            cg_nopredict;
 extern  vmCvar_t            cg_debugMove;
+extern  vmCvar_t            cg_debugTrace;
 extern  vmCvar_t            cg_noPlayerAnims;
 extern  vmCvar_t            cg_showmiss;
 extern  vmCvar_t            cg_footsteps;
@@ -1816,10 +1821,15 @@ extern  vmCvar_t            cg_drawEntityInfo;
 extern  vmCvar_t            cg_wwSmoothTime;
 extern  vmCvar_t            cg_disableBlueprintErrors;
 extern  vmCvar_t            cg_depthSortParticles;
+extern  vmCvar_t            cg_batchParticles;
 extern  vmCvar_t            cg_bounceParticles;
 extern  vmCvar_t            cg_consoleLatency;
 extern  vmCvar_t            cg_lightFlare;
 extern  vmCvar_t            cg_debugParticles;
+extern  vmCvar_t            cg_maxParticles;
+extern  vmCvar_t            cg_assetCache;
+extern  vmCvar_t            cg_debugLoading;
+extern  vmCvar_t            cg_volumeCache;
 extern  vmCvar_t            cg_debugTrails;
 extern  vmCvar_t            cg_debugPVS;
 extern  vmCvar_t            cg_disableWarningDialogs;
@@ -1924,6 +1934,7 @@ void     CG_TestModelPrevSkin_f();
 bool CG_CullBox(vec3_t mins, vec3_t maxs);
 bool CG_CullPointAndRadius(const vec3_t pt, vec_t radius);
 void     CG_DrawActiveFrame( int serverTime, bool demoPlayback );
+void     CG_ClearVolumeCache();
 void     CG_OffsetFirstPersonView();
 void     CG_OffsetThirdPersonView();
 void     CG_OffsetShoulderView();
@@ -2174,6 +2185,9 @@ bool         CG_IsParticleSystemValid( particleSystem_t **ps );
 void             CG_SetParticleSystemNormal( particleSystem_t *ps, vec3_t normal );
 void             CG_SetParticleSystemLastNormal( particleSystem_t *ps, const vec3_t normal );
 
+void             CG_ParticleOrigin( const particle_t *p, vec3_t origin );
+void             CG_ParticleVelocity( const particle_t *p, vec3_t velocity );
+
 void             CG_AddParticles();
 
 void             CG_ParticleSystemEntity( centity_t *cent );
@@ -2181,6 +2195,15 @@ void             CG_ParticleSystemEntity( centity_t *cent );
 void             CG_TestPS_f();
 void             CG_DestroyTestPS_f();
 
+//
+// cg_assetcache.c
+//
+uint64_t      CG_AssetCacheKey( const char *dir, const char *fileList, int numFiles, std::initializer_list<size_t> layout );
+bool          CG_LoadAssetCache( const char *name, uint64_t key, std::vector<byte> &data );
+void          CG_SaveAssetCache( const char *name, uint64_t key, const std::vector<byte> &data );
+void          CG_AssetCacheWrite( std::vector<byte> &data, const void *src, size_t len );
+bool          CG_AssetCacheRead( const std::vector<byte> &data, size_t &pos, void *dest, size_t len );
+
 //
 // cg_trails.c
 //
@@ -2231,6 +2254,7 @@ const char *CG_GetShaderNameFromHandle( const qhandle_t shader );
 void       CG_ReadableSize( char *buf, int bufsize, int value );
 void       CG_PrintTime( char *buf, int bufsize, int time );
 void CG_SetKeyCatcher( int catcher );
+std::string CG_LowercaseKey( const char *name );
 
 //
 // cg_rocket.c
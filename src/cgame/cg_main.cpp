@@ -68,6 +68,7 @@ vmCvar_t        cg_debugEvents;
 vmCvar_t        cg_errorDecay;
 vmCvar_t        cg_nopredict;
 vmCvar_t        cg_debugMove;
+vmCvar_t        cg_debugTrace;
 vmCvar_t        cg_noPlayerAnims;
 vmCvar_t        cg_showmiss;
 vmCvar_t        cg_footsteps;
@@ -113,10 +114,15 @@ vmCvar_t        cg_drawEntityInfo;
 vmCvar_t        cg_wwSmoothTime;
 vmCvar_t        cg_disableBlueprintErrors;
 vmCvar_t        cg_depthSortParticles;
+vmCvar_t        cg_batchParticles;
 vmCvar_t        cg_bounceParticles;
 vmCvar_t        cg_consoleLatency;
 vmCvar_t        cg_lightFlare;
 vmCvar_t        cg_debugParticles;
+vmCvar_t        cg_maxParticles;
+vmCvar_t        cg_assetCache;
+vmCvar_t        cg_debugLoading;
+vmCvar_t        cg_volumeCache;
 vmCvar_t        cg_debugTrails;
 vmCvar_t        cg_debugPVS;
 vmCvar_t        cg_disableWarningDialogs;
@@ -239,6 +245,7 @@ static const cvarTable_t cvarTable[] =
 	{ &cg_errorDecay,                  "cg_errordecay",                  "100",          0                            },
 	{ &cg_nopredict,                   "cg_nopredict",                   "0",            0                            },
 	{ &cg_debugMove,                   "cg_debugMove",                   "0",            0                            },
+	{ &cg_debugTrace,                  "cg_debugTrace",                  "0",            0                            },
 	{ &cg_noPlayerAnims,               "cg_noplayeranims",               "0",            CVAR_CHEAT                   },
 	{ &cg_showmiss,                    "cg_showmiss",                    "0",            0                            },
 	{ &cg_footsteps,                   "cg_footsteps",                   "1",            CVAR_CHEAT                   },
@@ -271,10 +278,15 @@ static const cvarTable_t cvarTable[] =
 	{ &cg_unlagged,                    "cg_unlagged",                    "1",            CVAR_USERINFO                },
 	{ nullptr,                            "cg_flySpeed",                    "800",          CVAR_USERINFO                },
 	{ &cg_depthSortParticles,          "cg_depthSortParticles",          "1",            0                            },
+	{ &cg_batchParticles,              "cg_batchParticles",              "1",            0                            },
 	{ &cg_bounceParticles,             "cg_bounceParticles",             "1",            0                            },
 	{ &cg_consoleLatency,              "cg_consoleLatency",              "3000",         0                            },
 	{ &cg_lightFlare,                  "cg_lightFlare",                  "3",            0                            },
 	{ &cg_debugParticles,              "cg_debugParticles",              "0",            CVAR_CHEAT                   },
+	{ &cg_maxParticles,                "cg_maxParticles",                "16384",        0                            },
+	{ &cg_assetCache,                  "cg_assetCache",                  "1",            0                            },
+	{ &cg_debugLoading,                "cg_debugLoading",                "0",            0                            },
+	{ &cg_volumeCache,                 "cg_volumeCache",                 "1",            0                            },
 	{ &cg_debugTrails,                 "cg_debugTrails",                 "0",            CVAR_CHEAT                   },
 	{ &cg_debugPVS,                    "cg_debugPVS",                    "0",            CVAR_CHEAT                   },
 	{ &cg_disableWarningDialogs,       "cg_disableWarningDialogs",       "0",            0                            },
@@ -783,29 +795,66 @@ enum {
 	LOAD_DONE
 } typedef cgLoadingStep_t;
 
-static void CG_UpdateLoadingStep( cgLoadingStep_t step )
+static const char *const loadingStepNames[ LOAD_DONE ] =
 {
-#if 0
-	static int startTime = 0;
-	static int lastStepTime = 0;
-	const int thisStepTime = trap_Milliseconds();
+	"",
+	"start",
+	"trails",
+	"particles",
+	"sounds",
+	"geometry",
+	"assets",
+	"configs",
+	"weapons",
+	"upgrades",
+	"classes",
+	"buildings",
+	"remaining",
+};
 
-	switch (step) {
-		case LOAD_START:
-			startTime = thisStepTime;
-			Log::Notice("^4%%^5 Start loading.");
-			break;
-		case LOAD_DONE:
-			Log::Notice("^4%%^5 Done loading everything after %is (%ims).",
-					(thisStepTime - startTime)/1000, (thisStepTime - startTime));
-			break;
-		default:
-			Log::Notice("^4%%^5 Done with Step %i after %is (%ims)… Starting Step %i",
-					step - 1, (thisStepTime - lastStepTime)/1000, (thisStepTime - lastStepTime), step );
-			break;
+/*
+=================
+CG_TimeLoadingStep
+
+Ends the timing of the previous loading step and prints the time of every
+step when done loading, with cg_debugLoading set.
+=================
+*/
+static void CG_TimeLoadingStep( cgLoadingStep_t step )
+{
+	static int stepTimes[ LOAD_DONE + 1 ];
+	static int startTime, lastStepTime, lastStep;
+	const int  thisStepTime = trap_Milliseconds();
+
+	if ( step == LOAD_START )
+	{
+		memset( stepTimes, 0, sizeof( stepTimes ) );
+		startTime = thisStepTime;
 	}
+	else
+	{
+		stepTimes[ lastStep ] += thisStepTime - lastStepTime;
+	}
+
 	lastStepTime = thisStepTime;
-#endif
+	lastStep = step;
+
+	if ( step != LOAD_DONE || !cg_debugLoading.integer )
+	{
+		return;
+	}
+
+	Log::Notice( "loaded %s in %ims:", cgs.mapname, thisStepTime - startTime );
+
+	for ( int i = LOAD_START; i < LOAD_DONE; i++ )
+	{
+		Log::Notice( "  %-10s %6ims", loadingStepNames[ i ], stepTimes[ i ] );
+	}
+}
+
+static void CG_UpdateLoadingStep( cgLoadingStep_t step )
+{
+	CG_TimeLoadingStep( step );
 
 	switch (step) {
 		case LOAD_START:
@@ -987,6 +1036,8 @@ void CG_RegisterGrading( int slot, const char *str )
 		trap_R_RegisterShader(texture, (RegisterShaderFlags_t) ( RSF_NOMIP | RSF_NOLIGHTSCALE ) );
 	cgs.gameGradingModels[ slot ] = model;
 	cgs.gameGradingDistances[ slot ] = dist;
+
+	CG_ClearVolumeCache();
 }
 
 /*
@@ -1013,6 +1064,8 @@ void CG_RegisterReverb( int slot, const char *str )
 	cgs.gameReverbModels[ slot ] = model;
 	cgs.gameReverbDistances[ slot ] = dist;
 	cgs.gameReverbIntensities[ slot ] = intensity;
+
+	CG_ClearVolumeCache();
 }
 
 /*
@@ -34,11 +34,58 @@ static int                   numBaseParticleSystems = 0;
 static int                   numBaseParticleEjectors = 0;
 static int                   numBaseParticles = 0;
 
+// base particle systems by lower case name
+static std::unordered_map<std::string, int> baseParticleSystemIndex;
+
 static particleSystem_t      particleSystems[ MAX_PARTICLE_SYSTEMS ];
 static particleEjector_t     particleEjectors[ MAX_PARTICLE_EJECTORS ];
-static particle_t            particles[ MAX_PARTICLES ];
-static particle_t            *sortedParticles[ MAX_PARTICLES ];
-static particle_t            *radixBuffer[ MAX_PARTICLES ];
+// particles live in blocks that are added as needed, so their addresses stay
+// valid for the attachments that point to them; only the first
+// cg_maxParticles slots are used, so the last block may be partly unused
+//
+// the state that is integrated every frame is kept next to them with one array
+// per component, so that whole blocks are integrated in loops the compiler can
+// vectorize, and only the particles that may collide are handled one by one
+struct particleBlock_t
+{
+	particle_t particles[ PARTICLE_BLOCK_SIZE ];
+
+	float      origin[ 3 ][ PARTICLE_BLOCK_SIZE ];
+	float      velocity[ 3 ][ PARTICLE_BLOCK_SIZE ];
+	float      acceleration[ 3 ][ PARTICLE_BLOCK_SIZE ];
+	float      nextOrigin[ 3 ][ PARTICLE_BLOCK_SIZE ]; // where the particle moves unless it collides
+	float      deltaTime[ PARTICLE_BLOCK_SIZE ];       // 0 for the ones that don't move this frame
+	int        lastEvalTime[ PARTICLE_BLOCK_SIZE ];
+};
+
+static std::vector<std::unique_ptr<particleBlock_t>> particleBlocks;
+static int                   numParticleSlots;
+static int                   nextParticleSlot; // where to start looking for a free slot
+static int                   particleLimitWarnTime;
+
+// the order to evaluate and render particles in, as indices into the slots
+static std::vector<int>      sortedParticles;
+// the particles that moved this frame and still need their collisions resolved
+static std::vector<int>      movingParticles;
+// depth sort keys, the distance in the high bits and the slot in the low bits
+static std::vector<uint64_t> particleSortKeys;
+static std::vector<uint64_t> radixBuffer;
+
+// sprite particles are collected as quads over a frame and handed to the
+// renderer in as few poly lists as possible
+struct particleQuad_t
+{
+	qhandle_t  shader;
+	polyVert_t verts[ 4 ];
+};
+
+static std::vector<particleQuad_t> particleQuads;
+static std::vector<int>      particleQuadOrder;
+static std::vector<polyVert_t> particleBatchVerts;
+
+// draw calls made for particles this frame, for cg_debugParticles
+static int                   numParticleEntitySubmits;
+static int                   numParticleBatchSubmits;
 
 /*
 ===============
@@ -99,6 +146,112 @@ static void CG_SpreadVector( vec3_t v, float spread )
 	VectorCopy( r2, v );
 }
 
+static inline particleBlock_t *CG_ParticleBlock( int slot )
+{
+	return particleBlocks[ slot / PARTICLE_BLOCK_SIZE ].get();
+}
+
+static inline particle_t *CG_Particle( int slot )
+{
+	return &CG_ParticleBlock( slot )->particles[ slot % PARTICLE_BLOCK_SIZE ];
+}
+
+void CG_ParticleOrigin( const particle_t *p, vec3_t origin )
+{
+	particleBlock_t *block = CG_ParticleBlock( p->slot );
+	int             i = p->slot % PARTICLE_BLOCK_SIZE;
+
+	VectorSet( origin, block->origin[ 0 ][ i ], block->origin[ 1 ][ i ], block->origin[ 2 ][ i ] );
+}
+
+void CG_ParticleVelocity( const particle_t *p, vec3_t velocity )
+{
+	particleBlock_t *block = CG_ParticleBlock( p->slot );
+	int             i = p->slot % PARTICLE_BLOCK_SIZE;
+
+	VectorSet( velocity, block->velocity[ 0 ][ i ], block->velocity[ 1 ][ i ], block->velocity[ 2 ][ i ] );
+}
+
+static void CG_SetParticleOrigin( particle_t *p, const vec3_t origin )
+{
+	particleBlock_t *block = CG_ParticleBlock( p->slot );
+	int             i = p->slot % PARTICLE_BLOCK_SIZE;
+
+	for ( int j = 0; j < 3; j++ )
+	{
+		block->origin[ j ][ i ] = origin[ j ];
+	}
+}
+
+static void CG_SetParticleVelocity( particle_t *p, const vec3_t velocity )
+{
+	particleBlock_t *block = CG_ParticleBlock( p->slot );
+	int             i = p->slot % PARTICLE_BLOCK_SIZE;
+
+	for ( int j = 0; j < 3; j++ )
+	{
+		block->velocity[ j ][ i ] = velocity[ j ];
+	}
+}
+
+/*
+===============
+CG_AllocParticle
+
+Finds a free particle slot, adding a block of them if all are taken
+===============
+*/
+static particle_t *CG_AllocParticle()
+{
+	for ( int n = 0; n < numParticleSlots; n++ )
+	{
+		int        slot = ( nextParticleSlot + n ) % numParticleSlots;
+		particle_t *p = CG_Particle( slot );
+
+		//FIXME: the + 1 may be unnecessary
+		if ( !p->valid && cg.clientFrame > p->frameWhenInvalidated + 1 )
+		{
+			nextParticleSlot = slot + 1;
+			return p;
+		}
+	}
+
+	if ( numParticleSlots >= cg_maxParticles.integer )
+	{
+		if ( cg.time > particleLimitWarnTime + 1000 || cg.time < particleLimitWarnTime )
+		{
+			Log::Warn( "particle limit of %d reached, effects are dropped (cg_maxParticles)", numParticleSlots );
+			particleLimitWarnTime = cg.time;
+		}
+
+		return nullptr;
+	}
+
+	// the last block may still have slots beyond an earlier limit
+	if ( numParticleSlots % PARTICLE_BLOCK_SIZE == 0 )
+	{
+		particleBlocks.emplace_back( new particleBlock_t() );
+
+		for ( int i = 0; i < PARTICLE_BLOCK_SIZE; i++ )
+		{
+			particleBlocks.back()->particles[ i ].slot = numParticleSlots + i;
+		}
+	}
+
+	int firstSlot = numParticleSlots;
+
+	numParticleSlots = std::min( ( firstSlot / PARTICLE_BLOCK_SIZE + 1 ) * PARTICLE_BLOCK_SIZE,
+	                             cg_maxParticles.integer );
+	nextParticleSlot = firstSlot + 1;
+
+	if ( cg_debugParticles.integer >= 1 )
+	{
+		Log::Debug( "particle slots grown to %d", numParticleSlots );
+	}
+
+	return CG_Particle( firstSlot );
+}
+
 /*
 ===============
 CG_DestroyParticle
@@ -117,17 +270,21 @@ static void CG_DestroyParticle( particle_t *p, vec3_t impactNormal )
 
 		if ( CG_IsParticleSystemValid( &ps ) )
 		{
+			vec3_t origin;
+
 			if ( impactNormal )
 			{
 				CG_SetParticleSystemNormal( ps, impactNormal );
 			}
 
-			CG_SetAttachmentPoint( &ps->attachment, p->origin );
+			CG_ParticleOrigin( p, origin );
+			CG_SetAttachmentPoint( &ps->attachment, origin );
 			CG_AttachToPoint( &ps->attachment );
 		}
 	}
 
 	p->valid = false;
+	p->parent->numParticles--;
 
 	//this gives other systems a couple of
 	//frames to realise the particle is gone
@@ -143,231 +300,236 @@ Introduce a new particle into the world
 */
 static particle_t *CG_SpawnNewParticle( baseParticle_t *bp, particleEjector_t *parent )
 {
-	int               i, j;
+	int               j;
 	particle_t        *p = nullptr;
 	particleEjector_t *pe = parent;
 	particleSystem_t  *ps = parent->parent;
 	vec3_t            attachmentPoint, attachmentVelocity;
 	vec3_t            transform[ 3 ];
+	vec3_t            origin, velocity;
+	int               slot;
+
+	p = CG_AllocParticle();
 
-	for ( i = 0; i < MAX_PARTICLES; i++ )
+	if ( !p )
 	{
-		p = &particles[ i ];
+		return nullptr;
+	}
 
-		//FIXME: the + 1 may be unnecessary
-		if ( !p->valid && cg.clientFrame > p->frameWhenInvalidated + 1 )
-		{
-			memset( p, 0, sizeof( particle_t ) );
+	slot = p->slot;
+	memset( p, 0, sizeof( particle_t ) );
+	p->slot = slot;
 
-			//found a free slot
-			p->class_ = bp;
-			p->parent = pe;
+	//found a free slot
+	p->class_ = bp;
+	p->parent = pe;
 
-			p->birthTime = cg.time;
-			p->lifeTime = ( int ) CG_RandomiseValue( ( float ) bp->lifeTime, bp->lifeTimeRandFrac );
+	p->birthTime = cg.time;
+	p->lifeTime = ( int ) CG_RandomiseValue( ( float ) bp->lifeTime, bp->lifeTimeRandFrac );
 
-			p->radius.delay = ( int ) CG_RandomiseValue( ( float ) bp->radius.delay, bp->radius.delayRandFrac );
-			p->radius.initial = CG_RandomiseValue( bp->radius.initial, bp->radius.initialRandFrac );
-			p->radius.final = CG_RandomiseValue( bp->radius.final, bp->radius.finalRandFrac );
+	p->radius.delay = ( int ) CG_RandomiseValue( ( float ) bp->radius.delay, bp->radius.delayRandFrac );
+	p->radius.initial = CG_RandomiseValue( bp->radius.initial, bp->radius.initialRandFrac );
+	p->radius.final = CG_RandomiseValue( bp->radius.final, bp->radius.finalRandFrac );
 
-			p->radius.initial += bp->scaleWithCharge * pe->parent->charge;
+	p->radius.initial += bp->scaleWithCharge * pe->parent->charge;
 
-			p->alpha.delay = ( int ) CG_RandomiseValue( ( float ) bp->alpha.delay, bp->alpha.delayRandFrac );
-			p->alpha.initial = CG_RandomiseValue( bp->alpha.initial, bp->alpha.initialRandFrac );
-			p->alpha.final = CG_RandomiseValue( bp->alpha.final, bp->alpha.finalRandFrac );
+	p->alpha.delay = ( int ) CG_RandomiseValue( ( float ) bp->alpha.delay, bp->alpha.delayRandFrac );
+	p->alpha.initial = CG_RandomiseValue( bp->alpha.initial, bp->alpha.initialRandFrac );
+	p->alpha.final = CG_RandomiseValue( bp->alpha.final, bp->alpha.finalRandFrac );
 
-			p->rotation.delay = ( int ) CG_RandomiseValue( ( float ) bp->rotation.delay, bp->rotation.delayRandFrac );
-			p->rotation.initial = CG_RandomiseValue( bp->rotation.initial, bp->rotation.initialRandFrac );
-			p->rotation.final = CG_RandomiseValue( bp->rotation.final, bp->rotation.finalRandFrac );
+	p->rotation.delay = ( int ) CG_RandomiseValue( ( float ) bp->rotation.delay, bp->rotation.delayRandFrac );
+	p->rotation.initial = CG_RandomiseValue( bp->rotation.initial, bp->rotation.initialRandFrac );
+	p->rotation.final = CG_RandomiseValue( bp->rotation.final, bp->rotation.finalRandFrac );
 
-			p->dLightRadius.delay =
-			  ( int ) CG_RandomiseValue( ( float ) bp->dLightRadius.delay, bp->dLightRadius.delayRandFrac );
-			p->dLightRadius.initial =
-			  CG_RandomiseValue( bp->dLightRadius.initial, bp->dLightRadius.initialRandFrac );
-			p->dLightRadius.final =
-			  CG_RandomiseValue( bp->dLightRadius.final, bp->dLightRadius.finalRandFrac );
+	p->dLightRadius.delay =
+	  ( int ) CG_RandomiseValue( ( float ) bp->dLightRadius.delay, bp->dLightRadius.delayRandFrac );
+	p->dLightRadius.initial =
+	  CG_RandomiseValue( bp->dLightRadius.initial, bp->dLightRadius.initialRandFrac );
+	p->dLightRadius.final =
+	  CG_RandomiseValue( bp->dLightRadius.final, bp->dLightRadius.finalRandFrac );
 
-			p->colorDelay = CG_RandomiseValue( bp->colorDelay, bp->colorDelayRandFrac );
+	p->colorDelay = CG_RandomiseValue( bp->colorDelay, bp->colorDelayRandFrac );
 
-			p->bounceMarkRadius = CG_RandomiseValue( bp->bounceMarkRadius, bp->bounceMarkRadiusRandFrac );
-			p->bounceMarkCount =
-			  rint( CG_RandomiseValue( ( float ) bp->bounceMarkCount, bp->bounceMarkCountRandFrac ) );
-			p->bounceSoundCount =
-			  rint( CG_RandomiseValue( ( float ) bp->bounceSoundCount, bp->bounceSoundCountRandFrac ) );
+	p->bounceMarkRadius = CG_RandomiseValue( bp->bounceMarkRadius, bp->bounceMarkRadiusRandFrac );
+	p->bounceMarkCount =
+	  rint( CG_RandomiseValue( ( float ) bp->bounceMarkCount, bp->bounceMarkCountRandFrac ) );
+	p->bounceSoundCount =
+	  rint( CG_RandomiseValue( ( float ) bp->bounceSoundCount, bp->bounceSoundCountRandFrac ) );
 
-			if ( bp->numModels )
-			{
-				p->model = bp->models[ rand() % bp->numModels ];
+	if ( bp->numModels )
+	{
+		p->model = bp->models[ rand() % bp->numModels ];
 
-				if ( bp->modelAnimation.frameLerp < 0 )
-				{
-					bp->modelAnimation.frameLerp = p->lifeTime / bp->modelAnimation.numFrames;
-					bp->modelAnimation.initialLerp = p->lifeTime / bp->modelAnimation.numFrames;
-				}
-				else if ( bp->modelAnimation.frameLerp == 0 )
-				{
-					// Bypass calculations in CG_RunLerpFrame if there is no modelAnimation
-					// since it will try to divide by frameLerp
-					p->lf.animationTime = std::numeric_limits<int>::max();
-				}
-			}
+		if ( bp->modelAnimation.frameLerp < 0 )
+		{
+			bp->modelAnimation.frameLerp = p->lifeTime / bp->modelAnimation.numFrames;
+			bp->modelAnimation.initialLerp = p->lifeTime / bp->modelAnimation.numFrames;
+		}
+		else if ( bp->modelAnimation.frameLerp == 0 )
+		{
+			// Bypass calculations in CG_RunLerpFrame if there is no modelAnimation
+			// since it will try to divide by frameLerp
+			p->lf.animationTime = std::numeric_limits<int>::max();
+		}
+	}
 
-			if ( !CG_AttachmentPoint( &ps->attachment, attachmentPoint ) )
-			{
-				return nullptr;
-			}
+	if ( !CG_AttachmentPoint( &ps->attachment, attachmentPoint ) )
+	{
+		return nullptr;
+	}
 
-			VectorCopy( attachmentPoint, p->origin );
+	VectorCopy( attachmentPoint, origin );
+	VectorClear( velocity );
 
-			if ( CG_AttachmentAxis( &ps->attachment, transform ) )
-			{
-				vec3_t transDisplacement;
+	if ( CG_AttachmentAxis( &ps->attachment, transform ) )
+	{
+		vec3_t transDisplacement;
 
-				VectorMatrixMultiply( bp->displacement, transform, transDisplacement );
-				VectorAdd( p->origin, transDisplacement, p->origin );
+		VectorMatrixMultiply( bp->displacement, transform, transDisplacement );
+		VectorAdd( origin, transDisplacement, origin );
+	}
+	else
+	{
+		VectorAdd( origin, bp->displacement, origin );
+	}
+
+	for ( j = 0; j <= 2; j++ )
+	{
+		origin[ j ] += ( crandom() * bp->randDisplacement[ j ] );
+	}
+
+	switch ( bp->velMoveType )
+	{
+		case PMT_STATIC:
+			if ( bp->velMoveValues.dirType == PMD_POINT )
+			{
+				VectorSubtract( bp->velMoveValues.point, origin, velocity );
 			}
-			else
+			else if ( bp->velMoveValues.dirType == PMD_LINEAR )
 			{
-				VectorAdd( p->origin, bp->displacement, p->origin );
+				VectorCopy( bp->velMoveValues.dir, velocity );
 			}
 
-			for ( j = 0; j <= 2; j++ )
+			break;
+
+		case PMT_STATIC_TRANSFORM:
+			if ( !CG_AttachmentAxis( &ps->attachment, transform ) )
 			{
-				p->origin[ j ] += ( crandom() * bp->randDisplacement[ j ] );
+				return nullptr;
 			}
 
-			switch ( bp->velMoveType )
+			if ( bp->velMoveValues.dirType == PMD_POINT )
 			{
-				case PMT_STATIC:
-					if ( bp->velMoveValues.dirType == PMD_POINT )
-					{
-						VectorSubtract( bp->velMoveValues.point, p->origin, p->velocity );
-					}
-					else if ( bp->velMoveValues.dirType == PMD_LINEAR )
-					{
-						VectorCopy( bp->velMoveValues.dir, p->velocity );
-					}
-
-					break;
-
-				case PMT_STATIC_TRANSFORM:
-					if ( !CG_AttachmentAxis( &ps->attachment, transform ) )
-					{
-						return nullptr;
-					}
-
-					if ( bp->velMoveValues.dirType == PMD_POINT )
-					{
-						vec3_t transPoint;
+				vec3_t transPoint;
 
-						VectorMatrixMultiply( bp->velMoveValues.point, transform, transPoint );
-						VectorSubtract( transPoint, p->origin, p->velocity );
-					}
-					else if ( bp->velMoveValues.dirType == PMD_LINEAR )
-					{
-						VectorMatrixMultiply( bp->velMoveValues.dir, transform, p->velocity );
-					}
+				VectorMatrixMultiply( bp->velMoveValues.point, transform, transPoint );
+				VectorSubtract( transPoint, origin, velocity );
+			}
+			else if ( bp->velMoveValues.dirType == PMD_LINEAR )
+			{
+				VectorMatrixMultiply( bp->velMoveValues.dir, transform, velocity );
+			}
 
-					break;
+			break;
 
-				case PMT_TAG:
-				case PMT_CENT_ANGLES:
-					if ( bp->velMoveValues.dirType == PMD_POINT )
-					{
-						VectorSubtract( attachmentPoint, p->origin, p->velocity );
-					}
-					else if ( bp->velMoveValues.dirType == PMD_LINEAR )
-					{
-						if ( !CG_AttachmentDir( &ps->attachment, p->velocity ) )
-						{
-							return nullptr;
-						}
-					}
+		case PMT_TAG:
+		case PMT_CENT_ANGLES:
+			if ( bp->velMoveValues.dirType == PMD_POINT )
+			{
+				VectorSubtract( attachmentPoint, origin, velocity );
+			}
+			else if ( bp->velMoveValues.dirType == PMD_LINEAR )
+			{
+				if ( !CG_AttachmentDir( &ps->attachment, velocity ) )
+				{
+					return nullptr;
+				}
+			}
 
-					break;
+			break;
 
-				case PMT_NORMAL:
-					if ( !ps->normalValid )
-					{
-						Log::Warn("a particle with velocityType "
-						           "normal has no normal" );
-						return nullptr;
-					}
+		case PMT_NORMAL:
+			if ( !ps->normalValid )
+			{
+				Log::Warn("a particle with velocityType "
+				           "normal has no normal" );
+				return nullptr;
+			}
 
-					VectorCopy( ps->normal, p->velocity );
+			VectorCopy( ps->normal, velocity );
 
-					//normal displacement
-					VectorNormalize( p->velocity );
-					VectorMA( p->origin, bp->normalDisplacement, p->velocity, p->origin );
-					break;
+			//normal displacement
+			VectorNormalize( velocity );
+			VectorMA( origin, bp->normalDisplacement, velocity, origin );
+			break;
 
-				case PMT_LAST_NORMAL:
-					VectorCopy( ps->lastNormal, p->velocity );
-					VectorNormalize( p->velocity );
-					VectorMA( p->origin, bp->normalDisplacement, p->velocity, p->origin );
-					break;
+		case PMT_LAST_NORMAL:
+			VectorCopy( ps->lastNormal, velocity );
+			VectorNormalize( velocity );
+			VectorMA( origin, bp->normalDisplacement, velocity, origin );
+			break;
 
-				case PMT_OPPORTUNISTIC_NORMAL:
-					if ( ps->lastNormalIsCurrent )
-					{
-						VectorCopy( ps->lastNormal, p->velocity );
-						VectorNormalize( p->velocity );
-						VectorMA( p->origin, bp->normalDisplacement, p->velocity, p->origin );
-					}
-					break;
+		case PMT_OPPORTUNISTIC_NORMAL:
+			if ( ps->lastNormalIsCurrent )
+			{
+				VectorCopy( ps->lastNormal, velocity );
+				VectorNormalize( velocity );
+				VectorMA( origin, bp->normalDisplacement, velocity, origin );
 			}
+			break;
+	}
 
-			VectorNormalize( p->velocity );
-			CG_SpreadVector( p->velocity, bp->velMoveValues.dirRandAngle );
-			VectorScale( p->velocity,
-			             CG_RandomiseValue( bp->velMoveValues.mag, bp->velMoveValues.magRandFrac ),
-			             p->velocity );
+	VectorNormalize( velocity );
+	CG_SpreadVector( velocity, bp->velMoveValues.dirRandAngle );
+	VectorScale( velocity,
+	             CG_RandomiseValue( bp->velMoveValues.mag, bp->velMoveValues.magRandFrac ),
+	             velocity );
 
-			if ( CG_AttachmentVelocity( &ps->attachment, attachmentVelocity ) )
-			{
-				VectorMA( p->velocity,
-				          CG_RandomiseValue( bp->velMoveValues.parentVelFrac,
-				                             bp->velMoveValues.parentVelFracRandFrac ), attachmentVelocity, p->velocity );
-			}
+	if ( CG_AttachmentVelocity( &ps->attachment, attachmentVelocity ) )
+	{
+		VectorMA( velocity,
+		          CG_RandomiseValue( bp->velMoveValues.parentVelFrac,
+		                             bp->velMoveValues.parentVelFracRandFrac ), attachmentVelocity, velocity );
+	}
 
-			p->lastEvalTime = cg.time;
+	CG_SetParticleOrigin( p, origin );
+	CG_SetParticleVelocity( p, velocity );
+	CG_ParticleBlock( slot )->lastEvalTime[ slot % PARTICLE_BLOCK_SIZE ] = cg.time;
 
-			p->valid = true;
+	p->valid = true;
 
-			//this particle has a child particle system attached
-			if ( bp->childSystemName[ 0 ] != '\0' )
-			{
-				particleSystem_t *chps = CG_SpawnNewParticleSystem( bp->childSystemHandle );
+	//this particle has a child particle system attached
+	if ( bp->childSystemName[ 0 ] != '\0' )
+	{
+		particleSystem_t *chps = CG_SpawnNewParticleSystem( bp->childSystemHandle );
 
-				if ( CG_IsParticleSystemValid( &chps ) )
-				{
-					CG_SetAttachmentParticle( &chps->attachment, p );
-					CG_AttachToParticle( &chps->attachment );
-					p->childParticleSystem = chps;
-
-					if ( ps->lastNormalIsCurrent )
-						CG_SetParticleSystemLastNormal( chps, ps->lastNormal );
-					else
-						VectorCopy( ps->lastNormal, chps->lastNormal );
-				}
-			}
+		if ( CG_IsParticleSystemValid( &chps ) )
+		{
+			CG_SetAttachmentParticle( &chps->attachment, p );
+			CG_AttachToParticle( &chps->attachment );
+			p->childParticleSystem = chps;
 
-			//this particle has a child trail system attached
-			if ( bp->childTrailSystemName[ 0 ] != '\0' )
-			{
-				trailSystem_t *ts = CG_SpawnNewTrailSystem( bp->childTrailSystemHandle );
+			if ( ps->lastNormalIsCurrent )
+				CG_SetParticleSystemLastNormal( chps, ps->lastNormal );
+			else
+				VectorCopy( ps->lastNormal, chps->lastNormal );
+		}
+	}
 
-				if ( CG_IsTrailSystemValid( &ts ) )
-				{
-					CG_SetAttachmentParticle( &ts->frontAttachment, p );
-					CG_AttachToParticle( &ts->frontAttachment );
-				}
-			}
+	//this particle has a child trail system attached
+	if ( bp->childTrailSystemName[ 0 ] != '\0' )
+	{
+		trailSystem_t *ts = CG_SpawnNewTrailSystem( bp->childTrailSystemHandle );
 
-			break;
+		if ( CG_IsTrailSystemValid( &ts ) )
+		{
+			CG_SetAttachmentParticle( &ts->frontAttachment, p );
+			CG_AttachToParticle( &ts->frontAttachment );
 		}
 	}
 
+	pe->numParticles++;
+
 	return p;
 }
 
@@ -382,12 +544,10 @@ introducing new particles
 static void CG_SpawnNewParticles()
 {
 	int                   i, j;
-	particle_t            *p;
 	particleSystem_t      *ps;
 	particleEjector_t     *pe;
 	baseParticleEjector_t *bpe;
 	float                 lerpFrac;
-	int                   count;
 
 	for ( i = 0; i < MAX_PARTICLE_EJECTORS; i++ )
 	{
@@ -430,25 +590,10 @@ static void CG_SpawnNewParticles()
 				}
 			}
 
-			if ( pe->count == 0 || ps->lazyRemove )
+			//wait for child particles to die before declaring this pe invalid
+			if ( ( pe->count == 0 || ps->lazyRemove ) && !pe->numParticles )
 			{
-				count = 0;
-
-				//wait for child particles to die before declaring this pe invalid
-				for ( j = 0; j < MAX_PARTICLES; j++ )
-				{
-					p = &particles[ j ];
-
-					if ( p->valid && p->parent == pe )
-					{
-						count++;
-					}
-				}
-
-				if ( !count )
-				{
-					pe->valid = false;
-				}
+				pe->valid = false;
 			}
 		}
 	}
@@ -503,6 +648,25 @@ static particleEjector_t *CG_SpawnNewParticleEjector( baseParticleEjector_t *bpe
 	return pe;
 }
 
+/*
+===============
+CG_FindBaseParticleSystem
+
+Returns the index of the base particle system with that name, or -1
+===============
+*/
+static int CG_FindBaseParticleSystem( const char *name )
+{
+	auto it = baseParticleSystemIndex.find( CG_LowercaseKey( name ) );
+
+	return it == baseParticleSystemIndex.end() ? -1 : it->second;
+}
+
+static void CG_IndexBaseParticleSystem( int index )
+{
+	baseParticleSystemIndex[ CG_LowercaseKey( baseParticleSystems[ index ].name ) ] = index;
+}
+
 /*
 ===============
 CG_SpawnNewParticleSystem
@@ -570,84 +734,83 @@ qhandle_t CG_RegisterParticleSystem( const char *name )
 	baseParticleEjector_t *bpe;
 	baseParticle_t        *bp;
 
-	for ( i = 0; i < MAX_BASEPARTICLE_SYSTEMS; i++ )
-	{
-		bps = &baseParticleSystems[ i ];
+	i = CG_FindBaseParticleSystem( name );
 
-		if ( !Q_strnicmp( bps->name, name, MAX_QPATH ) )
-		{
-			//already registered
-			if ( bps->registered )
-			{
-				return i + 1;
-			}
-
-			for ( j = 0; j < bps->numEjectors; j++ )
-			{
-				bpe = bps->ejectors[ j ];
+	if ( i < 0 )
+	{
+		Log::Warn("failed to register particle system %s", name);
+		return 0;
+	}
 
-				for ( l = 0; l < bpe->numParticles; l++ )
-				{
-					bp = bpe->particles[ l ];
+	bps = &baseParticleSystems[ i ];
 
-					for ( k = 0; k < bp->numFrames; k++ )
-					{
-						bp->shaders[ k ] = trap_R_RegisterShader(bp->shaderNames[k],
-											 RSF_SPRITE);
-					}
+	//already registered
+	if ( bps->registered )
+	{
+		return i + 1;
+	}
 
-					for ( k = 0; k < bp->numModels; k++ )
-					{
-						bp->models[ k ] = trap_R_RegisterModel( bp->modelNames[ k ] );
-					}
+	for ( j = 0; j < bps->numEjectors; j++ )
+	{
+		bpe = bps->ejectors[ j ];
 
-					if ( bp->bounceMarkName[ 0 ] != '\0' )
-					{
-						bp->bounceMark = trap_R_RegisterShader(bp->bounceMarkName,
-										       RSF_DEFAULT);
-					}
+		for ( l = 0; l < bpe->numParticles; l++ )
+		{
+			bp = bpe->particles[ l ];
 
-					if ( bp->bounceSoundName[ 0 ] != '\0' )
-					{
-						bp->bounceSound = trap_S_RegisterSound( bp->bounceSoundName, false );
-					}
+			for ( k = 0; k < bp->numFrames; k++ )
+			{
+				bp->shaders[ k ] = trap_R_RegisterShader(bp->shaderNames[k],
+									 RSF_SPRITE);
+			}
 
-					//recursively register any children
-					if ( bp->childSystemName[ 0 ] != '\0' )
-					{
-						//don't care about a handle for children since
-						//the system deals with it
-						CG_RegisterParticleSystem( bp->childSystemName );
-					}
+			for ( k = 0; k < bp->numModels; k++ )
+			{
+				bp->models[ k ] = trap_R_RegisterModel( bp->modelNames[ k ] );
+			}
 
-					if ( bp->onDeathSystemName[ 0 ] != '\0' )
-					{
-						//don't care about a handle for children since
-						//the system deals with it
-						CG_RegisterParticleSystem( bp->onDeathSystemName );
-					}
+			if ( bp->bounceMarkName[ 0 ] != '\0' )
+			{
+				bp->bounceMark = trap_R_RegisterShader(bp->bounceMarkName,
+								       RSF_DEFAULT);
+			}
 
-					if ( bp->childTrailSystemName[ 0 ] != '\0' )
-					{
-						bp->childTrailSystemHandle = CG_RegisterTrailSystem( bp->childTrailSystemName );
-					}
-				}
+			if ( bp->bounceSoundName[ 0 ] != '\0' )
+			{
+				bp->bounceSound = trap_S_RegisterSound( bp->bounceSoundName, false );
 			}
 
-			if ( cg_debugParticles.integer >= 1 )
+			//recursively register any children
+			if ( bp->childSystemName[ 0 ] != '\0' )
 			{
-				Log::Debug( "Registered particle system %s", name );
+				//don't care about a handle for children since
+				//the system deals with it
+				CG_RegisterParticleSystem( bp->childSystemName );
 			}
 
-			bps->registered = true;
+			if ( bp->onDeathSystemName[ 0 ] != '\0' )
+			{
+				//don't care about a handle for children since
+				//the system deals with it
+				CG_RegisterParticleSystem( bp->onDeathSystemName );
+			}
 
-			//avoid returning 0
-			return i + 1;
+			if ( bp->childTrailSystemName[ 0 ] != '\0' )
+			{
+				bp->childTrailSystemHandle = CG_RegisterTrailSystem( bp->childTrailSystemName );
+			}
 		}
 	}
 
-	Log::Warn("failed to register particle system %s", name);
-	return 0;
+	if ( cg_debugParticles.integer >= 1 )
+	{
+		Log::Debug( "Registered particle system %s", name );
+	}
+
+	bps->registered = true;
+
+	//avoid returning 0
+	return i + 1;
 }
 
 /*
@@ -1736,7 +1899,6 @@ Load the particle systems from a particle file
 static bool CG_ParseParticleFile( const char *fileName )
 {
 	const char         *text_p;
-	int          i;
 	int          len;
 	char         *token;
 	char         text[ 32000 ];
@@ -1798,6 +1960,7 @@ static bool CG_ParseParticleFile( const char *fileName )
 					return false;
 				}
 
+				CG_IndexBaseParticleSystem( numBaseParticleSystems );
 				numBaseParticleSystems++;
 			}
 			else
@@ -1806,36 +1969,356 @@ static bool CG_ParseParticleFile( const char *fileName )
 				return false;
 			}
 		}
-		else if ( !psNameSet )
+		else if ( !psNameSet )
+		{
+			Q_strncpyz( psName, token, sizeof( psName ) );
+
+			//check for name space clashes
+			if ( CG_FindBaseParticleSystem( psName ) >= 0 )
+			{
+				Log::Warn( "a particle system is already named %s", psName );
+				SkipBracedSection( &text_p );
+				continue;
+			}
+
+			psNameSet = true;
+		}
+		else
+		{
+			Log::Warn( "particle system already named" );
+			return false;
+		}
+	}
+
+	return true;
+}
+
+static void CG_ClearBaseParticleSystems()
+{
+	numBaseParticleSystems = 0;
+	numBaseParticleEjectors = 0;
+	numBaseParticles = 0;
+	baseParticleSystemIndex.clear();
+
+	memset( baseParticleSystems, 0, sizeof( baseParticleSystems ) );
+	memset( baseParticleEjectors, 0, sizeof( baseParticleEjectors ) );
+	memset( baseParticles, 0, sizeof( baseParticles ) );
+}
+
+// changes whenever the cached structures do
+#define PARTICLE_CACHE_LAYOUT { sizeof( baseParticle_t ), sizeof( baseParticleEjector_t ), \
+                                sizeof( baseParticleSystem_t ), ( size_t ) PMT_OPPORTUNISTIC_NORMAL + 1 }
+
+/*
+===============
+CG_SaveParticleCache
+
+Saves the parsed base particle systems, with the pointers between them
+stored as indices since they are loaded to the same arrays.
+===============
+*/
+static void CG_SaveParticleCache( uint64_t key )
+{
+	std::vector<byte> data;
+
+	CG_AssetCacheWrite( data, &numBaseParticles, sizeof( numBaseParticles ) );
+	CG_AssetCacheWrite( data, &numBaseParticleEjectors, sizeof( numBaseParticleEjectors ) );
+	CG_AssetCacheWrite( data, &numBaseParticleSystems, sizeof( numBaseParticleSystems ) );
+
+	CG_AssetCacheWrite( data, baseParticles, numBaseParticles * sizeof( baseParticle_t ) );
+
+	for ( int i = 0; i < numBaseParticleEjectors; i++ )
+	{
+		const baseParticleEjector_t *bpe = &baseParticleEjectors[ i ];
+
+		CG_AssetCacheWrite( data, bpe, sizeof( *bpe ) );
+
+		for ( int j = 0; j < bpe->numParticles; j++ )
+		{
+			int index = bpe->particles[ j ] - baseParticles;
+			CG_AssetCacheWrite( data, &index, sizeof( index ) );
+		}
+	}
+
+	for ( int i = 0; i < numBaseParticleSystems; i++ )
+	{
+		const baseParticleSystem_t *bps = &baseParticleSystems[ i ];
+
+		CG_AssetCacheWrite( data, bps, sizeof( *bps ) );
+
+		for ( int j = 0; j < bps->numEjectors; j++ )
+		{
+			int index = bps->ejectors[ j ] - baseParticleEjectors;
+			CG_AssetCacheWrite( data, &index, sizeof( index ) );
+		}
+	}
+
+	CG_SaveAssetCache( "particles", key, data );
+}
+
+static bool CG_ReadParticleCache( const std::vector<byte> &data )
+{
+	size_t pos = 0;
+
+	if ( !CG_AssetCacheRead( data, pos, &numBaseParticles, sizeof( numBaseParticles ) ) ||
+	     !CG_AssetCacheRead( data, pos, &numBaseParticleEjectors, sizeof( numBaseParticleEjectors ) ) ||
+	     !CG_AssetCacheRead( data, pos, &numBaseParticleSystems, sizeof( numBaseParticleSystems ) ) )
+	{
+		return false;
+	}
+
+	if ( numBaseParticles < 0 || numBaseParticles > MAX_BASEPARTICLES ||
+	     numBaseParticleEjectors < 0 || numBaseParticleEjectors > MAX_BASEPARTICLE_EJECTORS ||
+	     numBaseParticleSystems < 0 || numBaseParticleSystems > MAX_BASEPARTICLE_SYSTEMS )
+	{
+		return false;
+	}
+
+	if ( !CG_AssetCacheRead( data, pos, baseParticles, numBaseParticles * sizeof( baseParticle_t ) ) )
+	{
+		return false;
+	}
+
+	for ( int i = 0; i < numBaseParticleEjectors; i++ )
+	{
+		baseParticleEjector_t *bpe = &baseParticleEjectors[ i ];
+
+		if ( !CG_AssetCacheRead( data, pos, bpe, sizeof( *bpe ) ) ||
+		     bpe->numParticles < 0 || bpe->numParticles > MAX_PARTICLES_PER_EJECTOR )
+		{
+			return false;
+		}
+
+		// the pointers were saved as they were in the process that wrote the cache
+		memset( bpe->particles, 0, sizeof( bpe->particles ) );
+
+		for ( int j = 0; j < bpe->numParticles; j++ )
+		{
+			int index;
+
+			if ( !CG_AssetCacheRead( data, pos, &index, sizeof( index ) ) ||
+			     index < 0 || index >= numBaseParticles )
+			{
+				return false;
+			}
+
+			bpe->particles[ j ] = &baseParticles[ index ];
+		}
+	}
+
+	for ( int i = 0; i < numBaseParticleSystems; i++ )
+	{
+		baseParticleSystem_t *bps = &baseParticleSystems[ i ];
+
+		if ( !CG_AssetCacheRead( data, pos, bps, sizeof( *bps ) ) ||
+		     bps->numEjectors < 0 || bps->numEjectors > MAX_EJECTORS_PER_SYSTEM )
+		{
+			return false;
+		}
+
+		memset( bps->ejectors, 0, sizeof( bps->ejectors ) );
+
+		for ( int j = 0; j < bps->numEjectors; j++ )
+		{
+			int index;
+
+			if ( !CG_AssetCacheRead( data, pos, &index, sizeof( index ) ) ||
+			     index < 0 || index >= numBaseParticleEjectors )
+			{
+				return false;
+			}
+
+			bps->ejectors[ j ] = &baseParticleEjectors[ index ];
+		}
+
+		CG_IndexBaseParticleSystem( i );
+	}
+
+	return pos == data.size();
+}
+
+/*
+===============
+CG_LoadParticleCache
+
+Loads the base particle systems from the asset cache instead of parsing
+the .particle files, if it is up to date.
+===============
+*/
+static bool CG_LoadParticleCache( uint64_t key )
+{
+	std::vector<byte> data;
+
+	if ( !CG_LoadAssetCache( "particles", key, data ) )
+	{
+		return false;
+	}
+
+	if ( !CG_ReadParticleCache( data ) )
+	{
+		Log::Warn( "particle cache is invalid, parsing the particle files" );
+		CG_ClearBaseParticleSystems();
+		return false;
+	}
+
+	return true;
+}
+
+/*
+===============
+CG_ParticleShaderKey
+
+A shader name the way the renderer looks it up
+===============
+*/
+static std::string CG_ParticleShaderKey( const char *name )
+{
+	std::string key = CG_LowercaseKey( name );
+	size_t      dot = key.rfind( '.' );
+
+	if ( dot != std::string::npos && key.find( '/', dot ) == std::string::npos )
+	{
+		key.erase( dot );
+	}
+
+	return key;
+}
+
+/*
+===============
+CG_IsTimedShaderToken
+
+Whether a shader keyword makes the shader change over time
+===============
+*/
+static bool CG_IsTimedShaderToken( const char *token )
+{
+	static const char *const timedTokens[] =
+	{
+		"animMap", "clampAnimMap", "oneshotAnimMap", "videoMap",
+		"sin", "triangle", "square", "sawtooth", "inversesawtooth", "noise",
+		"scroll", "rotate", "turb", "bulge"
+	};
+
+	for ( const char *timed : timedTokens )
+	{
+		if ( !Q_stricmp( token, timed ) )
+		{
+			return true;
+		}
+	}
+
+	// expressions such as "alpha 1 - time"
+	return CG_LowercaseKey( token ).find( "time" ) != std::string::npos;
+}
+
+/*
+===============
+CG_FindTimedParticleShaders
+
+Sprite batches are drawn on the global shader time rather than the age of
+each particle, so particles whose shaders animate on their own are kept as
+entities. Shaders without a script are plain images and never animate.
+===============
+*/
+static void CG_FindTimedParticleShaders()
+{
+	std::unordered_map<std::string, bool> timed;
+	// there are a lot more shader files than particle files
+	std::vector<char> fileList( 8 * MAX_PARTICLE_FILES * MAX_QPATH );
+	int  i, j, numFiles, fileLen;
+	char fileName[ MAX_QPATH ];
+	char *filePtr;
+
+	for ( i = 0; i < numBaseParticles; i++ )
+	{
+		for ( j = 0; j < baseParticles[ i ].numFrames; j++ )
+		{
+			timed[ CG_ParticleShaderKey( baseParticles[ i ].shaderNames[ j ] ) ] = false;
+		}
+	}
+
+	numFiles = trap_FS_GetFileList( "scripts", ".shader", fileList.data(), fileList.size() );
+	filePtr = fileList.data();
+
+	for ( i = 0; i < numFiles; i++, filePtr += fileLen + 1 )
+	{
+		std::string  text;
+		fileHandle_t f;
+		const char   *text_p;
+		int          len;
+
+		fileLen = strlen( filePtr );
+		Com_sprintf( fileName, sizeof( fileName ), "scripts/%s", filePtr );
+
+		len = trap_FS_FOpenFile( fileName, &f, fsMode_t::FS_READ );
+
+		if ( len <= 0 )
+		{
+			if ( len == 0 )
+			{
+				trap_FS_FCloseFile( f );
+			}
+
+			continue;
+		}
+
+		text.resize( len + 1 );
+		trap_FS_Read( &text[ 0 ], len, f );
+		text[ len ] = '\0';
+		trap_FS_FCloseFile( f );
+
+		text_p = text.c_str();
+
+		while ( true )
 		{
-			Q_strncpyz( psName, token, sizeof( psName ) );
+			char *token = COM_Parse( &text_p );
 
-			//check for name space clashes
-			for ( i = 0; i < numBaseParticleSystems; i++ )
+			if ( !*token )
 			{
-				if ( !Q_stricmp( baseParticleSystems[ i ].name, psName ) )
-				{
-					Log::Warn( "a particle system is already named %s", psName );
-					break;
-				}
+				break;
 			}
 
-			if ( i < numBaseParticleSystems )
+			// tables and the like put more words before the body
+			auto shader = timed.find( CG_ParticleShaderKey( token ) );
+
+			do
 			{
-				SkipBracedSection( &text_p );
-				continue;
+				token = COM_Parse( &text_p );
 			}
+			while ( *token && strcmp( token, "{" ) );
 
-			psNameSet = true;
+			for ( int depth = 1; *token && depth > 0; )
+			{
+				token = COM_Parse( &text_p );
+
+				if ( !strcmp( token, "{" ) )
+				{
+					depth++;
+				}
+				else if ( !strcmp( token, "}" ) )
+				{
+					depth--;
+				}
+				else if ( shader != timed.end() && CG_IsTimedShaderToken( token ) )
+				{
+					shader->second = true;
+				}
+			}
 		}
-		else
+	}
+
+	for ( i = 0; i < numBaseParticles; i++ )
+	{
+		baseParticle_t *bp = &baseParticles[ i ];
+
+		bp->timedShaders = false;
+
+		for ( j = 0; j < bp->numFrames; j++ )
 		{
-			Log::Warn( "particle system already named" );
-			return false;
+			bp->timedShaders |= timed[ CG_ParticleShaderKey( bp->shaderNames[ j ] ) ];
 		}
 	}
-
-	return true;
 }
 
 /*
@@ -1847,39 +2330,28 @@ Load particle systems from .particle files
 */
 void CG_LoadParticleSystems()
 {
-	int  i, j, numFiles, fileLen;
-	char fileList[ MAX_PARTICLE_FILES * MAX_QPATH ];
-	char fileName[ MAX_QPATH ];
-	char *filePtr;
+	int      i, j, numFiles, fileLen;
+	char     fileList[ MAX_PARTICLE_FILES * MAX_QPATH ];
+	char     fileName[ MAX_QPATH ];
+	char     *filePtr;
+	uint64_t cacheKey;
 
 	//clear out the old
-	numBaseParticleSystems = 0;
-	numBaseParticleEjectors = 0;
-	numBaseParticles = 0;
-
-	for ( i = 0; i < MAX_BASEPARTICLE_SYSTEMS; i++ )
-	{
-		baseParticleSystem_t *bps = &baseParticleSystems[ i ];
-		memset( bps, 0, sizeof( baseParticleSystem_t ) );
-	}
-
-	for ( i = 0; i < MAX_BASEPARTICLE_EJECTORS; i++ )
-	{
-		baseParticleEjector_t *bpe = &baseParticleEjectors[ i ];
-		memset( bpe, 0, sizeof( baseParticleEjector_t ) );
-	}
-
-	for ( i = 0; i < MAX_BASEPARTICLES; i++ )
-	{
-		baseParticle_t *bp = &baseParticles[ i ];
-		memset( bp, 0, sizeof( baseParticle_t ) );
-	}
+	CG_ClearBaseParticleSystems();
 
 	//and bring in the new
 	numFiles = trap_FS_GetFileList( "scripts", ".particle",
 	                                fileList, MAX_PARTICLE_FILES * MAX_QPATH );
 	filePtr = fileList;
 
+	cacheKey = CG_AssetCacheKey( "scripts", fileList, numFiles, PARTICLE_CACHE_LAYOUT );
+
+	if ( CG_LoadParticleCache( cacheKey ) )
+	{
+		CG_FindTimedParticleShaders();
+		return;
+	}
+
 	for ( i = 0; i < numFiles; i++, filePtr += fileLen + 1 )
 	{
 		fileLen = strlen( filePtr );
@@ -1897,21 +2369,14 @@ void CG_LoadParticleSystems()
 		if ( bp->childSystemName[ 0 ] )
 		{
 			//particle class has a child, resolve the name
-			for ( j = 0; j < numBaseParticleSystems; j++ )
-			{
-				baseParticleSystem_t *bps = &baseParticleSystems[ j ];
-
-				if ( !Q_stricmp( bps->name, bp->childSystemName ) )
-				{
-					//FIXME: add checks for cycles and infinite children
-
-					bp->childSystemHandle = j + 1;
+			//FIXME: add checks for cycles and infinite children
+			j = CG_FindBaseParticleSystem( bp->childSystemName );
 
-					break;
-				}
+			if ( j >= 0 )
+			{
+				bp->childSystemHandle = j + 1;
 			}
-
-			if ( j == numBaseParticleSystems )
+			else
 			{
 				//couldn't find named particle system
 				Log::Warn( "failed to find child %s", bp->childSystemName );
@@ -1922,21 +2387,14 @@ void CG_LoadParticleSystems()
 		if ( bp->onDeathSystemName[ 0 ] )
 		{
 			//particle class has a child, resolve the name
-			for ( j = 0; j < numBaseParticleSystems; j++ )
-			{
-				baseParticleSystem_t *bps = &baseParticleSystems[ j ];
+			//FIXME: add checks for cycles and infinite children
+			j = CG_FindBaseParticleSystem( bp->onDeathSystemName );
 
-				if ( !Q_stricmp( bps->name, bp->onDeathSystemName ) )
-				{
-					//FIXME: add checks for cycles and infinite children
-
-					bp->onDeathSystemHandle = j + 1;
-
-					break;
-				}
+			if ( j >= 0 )
+			{
+				bp->onDeathSystemHandle = j + 1;
 			}
-
-			if ( j == numBaseParticleSystems )
+			else
 			{
 				//couldn't find named particle system
 				Log::Warn( "failed to find onDeath system %s", bp->onDeathSystemName );
@@ -1944,6 +2402,9 @@ void CG_LoadParticleSystems()
 			}
 		}
 	}
+
+	CG_SaveParticleCache( cacheKey );
+	CG_FindTimedParticleShaders();
 }
 
 /*
@@ -2175,33 +2636,35 @@ static float CG_CalculateTimeFrac( int birth, int life, int delay )
 
 /*
 ===============
-CG_EvaluateParticlePhysics
+CG_PrepareParticlePhysics
 
-Compute the physics on a specific particle
+Works out the acceleration of a particle for this frame and the time it is
+integrated over, returns false if the particle doesn't move this frame
 ===============
 */
-static void CG_EvaluateParticlePhysics( particle_t *p )
+static bool CG_PrepareParticlePhysics( particle_t *p )
 {
 	particleSystem_t *ps = p->parent->parent;
 	baseParticle_t   *bp = p->class_;
-	vec3_t           acceleration, newOrigin;
-	vec3_t           mins, maxs;
-	float            deltaTime, bounce, radius, dot;
-	trace_t          trace;
+	particleBlock_t  *block = CG_ParticleBlock( p->slot );
+	int              i = p->slot % PARTICLE_BLOCK_SIZE;
+	vec3_t           origin, acceleration;
 	vec3_t           transform[ 3 ];
 
 	if ( p->atRest )
 	{
-		VectorClear( p->velocity );
-		return;
+		CG_SetParticleVelocity( p, vec3_origin );
+		return false;
 	}
 
+	CG_ParticleOrigin( p, origin );
+
 	switch ( bp->accMoveType )
 	{
 		case PMT_STATIC:
 			if ( bp->accMoveValues.dirType == PMD_POINT )
 			{
-				VectorSubtract( bp->accMoveValues.point, p->origin, acceleration );
+				VectorSubtract( bp->accMoveValues.point, origin, acceleration );
 			}
 			else if ( bp->accMoveValues.dirType == PMD_LINEAR )
 			{
@@ -2213,7 +2676,7 @@ static void CG_EvaluateParticlePhysics( particle_t *p )
 		case PMT_STATIC_TRANSFORM:
 			if ( !CG_AttachmentAxis( &ps->attachment, transform ) )
 			{
-				return;
+				return false;
 			}
 
 			if ( bp->accMoveValues.dirType == PMD_POINT )
@@ -2221,7 +2684,7 @@ static void CG_EvaluateParticlePhysics( particle_t *p )
 				vec3_t transPoint;
 
 				VectorMatrixMultiply( bp->accMoveValues.point, transform, transPoint );
-				VectorSubtract( transPoint, p->origin, acceleration );
+				VectorSubtract( transPoint, origin, acceleration );
 			}
 			else if ( bp->accMoveValues.dirType == PMD_LINEAR )
 			{
@@ -2238,16 +2701,16 @@ static void CG_EvaluateParticlePhysics( particle_t *p )
 
 				if ( !CG_AttachmentPoint( &ps->attachment, point ) )
 				{
-					return;
+					return false;
 				}
 
-				VectorSubtract( point, p->origin, acceleration );
+				VectorSubtract( point, origin, acceleration );
 			}
 			else if ( bp->accMoveValues.dirType == PMD_LINEAR )
 			{
 				if ( !CG_AttachmentDir( &ps->attachment, acceleration ) )
 				{
-					return;
+					return false;
 				}
 			}
 
@@ -2256,7 +2719,7 @@ static void CG_EvaluateParticlePhysics( particle_t *p )
 		case PMT_NORMAL:
 			if ( !ps->normalValid )
 			{
-				return;
+				return false;
 			}
 
 			VectorCopy( ps->normal, acceleration );
@@ -2303,27 +2766,68 @@ static void CG_EvaluateParticlePhysics( particle_t *p )
 		             acceleration );
 	}
 
-	// Some particles have a visual radius that differs from their collision radius
-	if ( bp->physicsRadius )
+	for ( int j = 0; j < 3; j++ )
 	{
-		radius = bp->physicsRadius;
+		block->acceleration[ j ][ i ] = acceleration[ j ];
 	}
-	else
+
+	block->deltaTime[ i ] = ( float )( cg.time - block->lastEvalTime[ i ] ) * 0.001;
+	block->lastEvalTime[ i ] = cg.time;
+
+	return true;
+}
+
+/*
+===============
+CG_IntegrateParticles
+
+Moves all particles by their velocity and acceleration, the ones that don't
+move this frame have a delta time of 0
+===============
+*/
+static void CG_IntegrateParticles()
+{
+	for ( const std::unique_ptr<particleBlock_t> &block : particleBlocks )
 	{
-		radius = CG_LerpValues( p->radius.initial, p->radius.final,
-		                        CG_CalculateTimeFrac( p->birthTime, p->lifeTime,
-		                            p->radius.delay ) );
+		const float *deltaTime = block->deltaTime;
+
+		for ( int j = 0; j < 3; j++ )
+		{
+			const float *origin = block->origin[ j ];
+			const float *acceleration = block->acceleration[ j ];
+			float       *velocity = block->velocity[ j ];
+			float       *nextOrigin = block->nextOrigin[ j ];
+
+			for ( int i = 0; i < PARTICLE_BLOCK_SIZE; i++ )
+			{
+				velocity[ i ] += deltaTime[ i ] * acceleration[ i ];
+				nextOrigin[ i ] = origin[ i ] + deltaTime[ i ] * velocity[ i ];
+			}
+		}
 	}
+}
 
-	VectorSet( mins, -radius, -radius, -radius );
-	VectorSet( maxs, radius, radius, radius );
+/*
+===============
+CG_ResolveParticleMove
 
-	bounce = CG_RandomiseValue( bp->bounceFrac, bp->bounceFracRandFrac );
+Moves a particle that was integrated to its new origin, unless it hits
+something on the way
+===============
+*/
+static void CG_ResolveParticleMove( particle_t *p )
+{
+	particleSystem_t *ps = p->parent->parent;
+	baseParticle_t   *bp = p->class_;
+	particleBlock_t  *block = CG_ParticleBlock( p->slot );
+	int              i = p->slot % PARTICLE_BLOCK_SIZE;
+	vec3_t           origin, newOrigin, velocity;
+	vec3_t           mins, maxs;
+	float            bounce, radius, dot;
+	trace_t          trace;
 
-	deltaTime = ( float )( cg.time - p->lastEvalTime ) * 0.001;
-	VectorMA( p->velocity, deltaTime, acceleration, p->velocity );
-	VectorMA( p->origin, deltaTime, p->velocity, newOrigin );
-	p->lastEvalTime = cg.time;
+	CG_ParticleOrigin( p, origin );
+	VectorSet( newOrigin, block->nextOrigin[ 0 ][ i ], block->nextOrigin[ 1 ][ i ], block->nextOrigin[ 2 ][ i ] );
 
 	// we're not doing particle physics, but at least cull them in solids
 	if ( !cg_bounceParticles.integer )
@@ -2336,19 +2840,46 @@ static void CG_EvaluateParticlePhysics( particle_t *p )
 		}
 		else
 		{
-			VectorCopy( newOrigin, p->origin );
+			CG_SetParticleOrigin( p, newOrigin );
 		}
 
 		return;
 	}
 
-	CG_Trace( &trace, p->origin, mins, maxs, newOrigin, CG_AttachmentCentNum( &ps->attachment ),
+	//only colliders need to know what they hit
+	bounce = ( bp->bounceFrac != 0.0f || bp->bounceFracRandFrac != 0.0f ) ?
+	         CG_RandomiseValue( bp->bounceFrac, bp->bounceFracRandFrac ) : 0.0f;
+
+	if ( bounce == 0.0f )
+	{
+		CG_SetParticleOrigin( p, newOrigin );
+		if ( CG_IsParticleSystemValid( &p->childParticleSystem ) )
+			CG_SetParticleSystemLastNormal( p->childParticleSystem, nullptr );
+		return;
+	}
+
+	// Some particles have a visual radius that differs from their collision radius
+	if ( bp->physicsRadius )
+	{
+		radius = bp->physicsRadius;
+	}
+	else
+	{
+		radius = CG_LerpValues( p->radius.initial, p->radius.final,
+		                        CG_CalculateTimeFrac( p->birthTime, p->lifeTime,
+		                            p->radius.delay ) );
+	}
+
+	VectorSet( mins, -radius, -radius, -radius );
+	VectorSet( maxs, radius, radius, radius );
+
+	CG_Trace( &trace, origin, mins, maxs, newOrigin, CG_AttachmentCentNum( &ps->attachment ),
 	          CONTENTS_SOLID, 0 );
 
-	//not hit anything or not a collider
-	if ( trace.fraction == 1.0f || bounce == 0.0f )
+	//not hit anything
+	if ( trace.fraction == 1.0f )
 	{
-		VectorCopy( newOrigin, p->origin );
+		CG_SetParticleOrigin( p, newOrigin );
 		if ( CG_IsParticleSystemValid( &p->childParticleSystem ) )
 			CG_SetParticleSystemLastNormal( p->childParticleSystem, nullptr );
 		return;
@@ -2368,14 +2899,16 @@ static void CG_EvaluateParticlePhysics( particle_t *p )
 	}
 
 	//reflect the velocity on the trace plane
-	dot = DotProduct( p->velocity, trace.plane.normal );
-	VectorMA( p->velocity, -2.0f * dot, trace.plane.normal, p->velocity );
+	CG_ParticleVelocity( p, velocity );
+	dot = DotProduct( velocity, trace.plane.normal );
+	VectorMA( velocity, -2.0f * dot, trace.plane.normal, velocity );
 
-	VectorScale( p->velocity, bounce, p->velocity );
+	VectorScale( velocity, bounce, velocity );
+	CG_SetParticleVelocity( p, velocity );
 
 	if ( trace.plane.normal[ 2 ] > 0.5f &&
-	     ( p->velocity[ 2 ] < 40.0f ||
-	       p->velocity[ 2 ] < -cg.frametime * p->velocity[ 2 ] ) )
+	     ( velocity[ 2 ] < 40.0f ||
+	       velocity[ 2 ] < -cg.frametime * velocity[ 2 ] ) )
 	{
 		p->atRest = true;
 	}
@@ -2393,7 +2926,7 @@ static void CG_EvaluateParticlePhysics( particle_t *p )
 		p->bounceSoundCount--;
 	}
 
-	VectorCopy( trace.endpos, p->origin );
+	CG_SetParticleOrigin( p, trace.endpos );
 
 	if ( !trace.allsolid )
 	{
@@ -2402,6 +2935,55 @@ static void CG_EvaluateParticlePhysics( particle_t *p )
 	}
 }
 
+/*
+===============
+CG_EvaluateParticlePhysics
+
+Compute the physics of the live particles in the order of sortedParticles,
+destroying the ones whose time is up
+===============
+*/
+static void CG_EvaluateParticlePhysics()
+{
+	for ( const std::unique_ptr<particleBlock_t> &block : particleBlocks )
+	{
+		memset( block->deltaTime, 0, sizeof( block->deltaTime ) );
+	}
+
+	movingParticles.clear();
+
+	for ( int slot : sortedParticles )
+	{
+		particle_t *p = CG_Particle( slot );
+
+		if ( !p->valid )
+		{
+			continue;
+		}
+
+		if ( p->birthTime + p->lifeTime <= cg.time )
+		{
+			CG_DestroyParticle( p, nullptr );
+		}
+		else if ( CG_PrepareParticlePhysics( p ) )
+		{
+			movingParticles.push_back( slot );
+		}
+	}
+
+	CG_IntegrateParticles();
+
+	for ( int slot : movingParticles )
+	{
+		particle_t *p = CG_Particle( slot );
+
+		if ( p->valid )
+		{
+			CG_ResolveParticleMove( p );
+		}
+	}
+}
+
 #define GETKEY(x,y) ((( x ) >> (y) ) & 0xFF )
 
 /*
@@ -2409,7 +2991,7 @@ static void CG_EvaluateParticlePhysics( particle_t *p )
 CG_Radix
 ===============
 */
-static void CG_Radix( int bits, int size, particle_t **source, particle_t **dest )
+static void CG_Radix( int bits, int size, const uint64_t *source, uint64_t *dest )
 {
 	int count[ 256 ];
 	int index[ 256 ];
@@ -2419,7 +3001,7 @@ static void CG_Radix( int bits, int size, particle_t **source, particle_t **dest
 
 	for ( i = 0; i < size; i++ )
 	{
-		count[ GETKEY( source[ i ]->sortKey, bits ) ]++;
+		count[ GETKEY( source[ i ], bits ) ]++;
 	}
 
 	index[ 0 ] = 0;
@@ -2431,7 +3013,7 @@ static void CG_Radix( int bits, int size, particle_t **source, particle_t **dest
 
 	for ( i = 0; i < size; i++ )
 	{
-		dest[ index[ GETKEY( source[ i ]->sortKey, bits ) ]++ ] = source[ i ];
+		dest[ index[ GETKEY( source[ i ], bits ) ]++ ] = source[ i ];
 	}
 }
 
@@ -2439,81 +3021,136 @@ static void CG_Radix( int bits, int size, particle_t **source, particle_t **dest
 ===============
 CG_RadixSort
 
-Radix sort with 4 byte size buckets
+Radix sort of the distance in the upper 4 bytes of the keys
 ===============
 */
-static void CG_RadixSort( particle_t **source, particle_t **temp, int size )
+static void CG_RadixSort( uint64_t *source, uint64_t *temp, int size )
 {
-	CG_Radix( 0,   size, source, temp );
-	CG_Radix( 8,   size, temp, source );
-	CG_Radix( 16,  size, source, temp );
-	CG_Radix( 24,  size, temp, source );
+	CG_Radix( 32, size, source, temp );
+	CG_Radix( 40, size, temp, source );
+	CG_Radix( 48, size, source, temp );
+	CG_Radix( 56, size, temp, source );
 }
 
 /*
 ===============
 CG_CompactAndSortParticles
 
-Depth sort the particles
+Lists the particles to evaluate, farthest first if they are depth sorted
 ===============
 */
 static void CG_CompactAndSortParticles()
 {
-	int    i, j = 0;
-	int    numParticles;
+	int    i;
+	int    numParticles = 0;
 	vec3_t delta;
 
-	for ( i = 0; i < MAX_PARTICLES; i++ )
-	{
-		sortedParticles[ i ] = &particles[ i ];
-	}
+	sortedParticles.resize( numParticleSlots );
 
 	if ( !cg_depthSortParticles.integer )
 	{
+		for ( i = 0; i < numParticleSlots; i++ )
+		{
+			if ( CG_Particle( i )->valid )
+			{
+				sortedParticles[ numParticles++ ] = i;
+			}
+		}
+
+		sortedParticles.resize( numParticles );
 		return;
 	}
 
-	for ( i = MAX_PARTICLES - 1; i >= 0; i-- )
+	// sort the keys rather than the particles so that only the keys are moved around
+	particleSortKeys.resize( numParticleSlots );
+	radixBuffer.resize( numParticleSlots );
+
+	for ( i = 0; i < numParticleSlots; i++ )
 	{
-		if ( sortedParticles[ i ]->valid )
-		{
-			//find the first hole
-			while ( j < MAX_PARTICLES && sortedParticles[ j ]->valid )
-			{
-				j++;
-			}
+		particle_t *p = CG_Particle( i );
 
-			//no more holes
-			if ( j >= i )
-			{
-				break;
-			}
+		if ( p->valid )
+		{
+			particleBlock_t *block = CG_ParticleBlock( i );
+			int             j = i % PARTICLE_BLOCK_SIZE;
 
-			sortedParticles[ j ] = sortedParticles[ i ];
+			VectorSet( delta, block->origin[ 0 ][ j ] - cg.refdef.vieworg[ 0 ],
+			           block->origin[ 1 ][ j ] - cg.refdef.vieworg[ 1 ],
+			           block->origin[ 2 ][ j ] - cg.refdef.vieworg[ 2 ] );
+			uint32_t distance = ( uint32_t ) std::min( DotProduct( delta, delta ), 4294967040.0f );
+			particleSortKeys[ numParticles++ ] = ( ( uint64_t ) distance << 32 ) | ( uint32_t ) i;
 		}
 	}
 
-	numParticles = i;
+	CG_RadixSort( particleSortKeys.data(), radixBuffer.data(), numParticles );
 
-	//set sort keys
+	// farthest first
 	for ( i = 0; i < numParticles; i++ )
 	{
-		VectorSubtract( sortedParticles[ i ]->origin, cg.refdef.vieworg, delta );
-		sortedParticles[ i ]->sortKey = ( int ) DotProduct( delta, delta );
+		sortedParticles[ i ] = ( int )( particleSortKeys[ numParticles - i - 1 ] & 0xFFFFFFFF );
 	}
 
-	CG_RadixSort( sortedParticles, radixBuffer, numParticles );
+	sortedParticles.resize( numParticles );
+}
 
-	//FIXME: wtf?
-	//reverse order of particles array
-	for ( i = 0; i < numParticles; i++ )
+/*
+===============
+CG_BatchSprite
+
+Turns a sprite into a quad facing the view, like the renderer does, and
+queues it for CG_FlushSpriteBatches. Polys have no shader time of their own,
+so only particles without timed shaders can be batched.
+===============
+*/
+static void CG_BatchSprite( const refEntity_t *re )
+{
+	static const float st[ 4 ][ 2 ] = { { 0.0f, 0.0f }, { 1.0f, 0.0f }, { 1.0f, 1.0f }, { 0.0f, 1.0f } };
+	particleQuad_t     *quad;
+	vec3_t             left, up;
+	int                i;
+
+	particleQuads.emplace_back();
+	quad = &particleQuads.back();
+	quad->shader = re->customShader;
+
+	if ( re->rotation == 0.0f )
 	{
-		radixBuffer[ i ] = sortedParticles[ numParticles - i - 1 ];
+		VectorScale( cg.refdef.viewaxis[ 1 ], re->radius, left );
+		VectorScale( cg.refdef.viewaxis[ 2 ], re->radius, up );
 	}
+	else
+	{
+		float angle = DEG2RAD( re->rotation );
+		float s = sinf( angle ) * re->radius;
+		float c = cosf( angle ) * re->radius;
 
-	for ( i = 0; i < numParticles; i++ )
+		VectorScale( cg.refdef.viewaxis[ 1 ], c, left );
+		VectorMA( left, -s, cg.refdef.viewaxis[ 2 ], left );
+
+		VectorScale( cg.refdef.viewaxis[ 2 ], c, up );
+		VectorMA( up, s, cg.refdef.viewaxis[ 1 ], up );
+	}
+
+	VectorAdd( re->origin, left, quad->verts[ 0 ].xyz );
+	VectorAdd( quad->verts[ 0 ].xyz, up, quad->verts[ 0 ].xyz );
+
+	VectorSubtract( re->origin, left, quad->verts[ 1 ].xyz );
+	VectorAdd( quad->verts[ 1 ].xyz, up, quad->verts[ 1 ].xyz );
+
+	VectorSubtract( re->origin, left, quad->verts[ 2 ].xyz );
+	VectorSubtract( quad->verts[ 2 ].xyz, up, quad->verts[ 2 ].xyz );
+
+	VectorAdd( re->origin, left, quad->verts[ 3 ].xyz );
+	VectorSubtract( quad->verts[ 3 ].xyz, up, quad->verts[ 3 ].xyz );
+
+	for ( i = 0; i < 4; i++ )
 	{
-		sortedParticles[ i ] = radixBuffer[ i ];
+		quad->verts[ i ].st[ 0 ] = st[ i ][ 0 ];
+		quad->verts[ i ].st[ 1 ] = st[ i ][ 1 ];
+		quad->verts[ i ].modulate[ 0 ] = re->shaderRGBA.Red();
+		quad->verts[ i ].modulate[ 1 ] = re->shaderRGBA.Green();
+		quad->verts[ i ].modulate[ 2 ] = re->shaderRGBA.Blue();
+		quad->verts[ i ].modulate[ 3 ] = re->shaderRGBA.Alpha();
 	}
 }
 
@@ -2533,10 +3170,13 @@ static void CG_RenderParticle( particle_t *p )
 	particleSystem_t     *ps = p->parent->parent;
 	baseParticleSystem_t *bps = ps->class_;
 	vec3_t               alight, dlight, lightdir;
+	vec3_t               origin;
 	vec3_t               up = { 0.0f, 0.0f, 1.0f };
 
 	memset( &re, 0, sizeof( refEntity_t ) );
 
+	CG_ParticleOrigin( p, origin );
+
 	timeFrac = CG_CalculateTimeFrac( p->birthTime, p->lifeTime, 0 );
 
 	scale = CG_LerpValues( p->radius.initial,
@@ -2554,7 +3194,7 @@ static void CG_RenderParticle( particle_t *p )
 		//apply environmental lighting to the particle
 		if ( bp->realLight )
 		{
-			trap_R_LightForPoint( p->origin, alight, dlight, lightdir );
+			trap_R_LightForPoint( origin, alight, dlight, lightdir );
 
 			re.shaderRGBA.SetRed( alight[0] );
 			re.shaderRGBA.SetGreen( alight[1] );
@@ -2591,7 +3231,7 @@ static void CG_RenderParticle( particle_t *p )
 
 		// if the view would be "inside" the sprite, kill the sprite
 		// so it doesn't add too much overdraw
-		if ( Distance( p->origin, cg.refdef.vieworg ) < re.radius && bp->overdrawProtection )
+		if ( Distance( origin, cg.refdef.vieworg ) < re.radius && bp->overdrawProtection )
 		{
 			return;
 		}
@@ -2627,8 +3267,11 @@ static void CG_RenderParticle( particle_t *p )
 		}
 		else
 		{
+			vec3_t velocity;
+
 			// convert direction of travel into axis
-			VectorNormalize2( p->velocity, re.axis[ 0 ] );
+			CG_ParticleVelocity( p, velocity );
+			VectorNormalize2( velocity, re.axis[ 0 ] );
 
 			if ( re.axis[ 0 ][ 0 ] == 0.0f && re.axis[ 0 ][ 1 ] == 0.0f )
 			{
@@ -2675,7 +3318,7 @@ static void CG_RenderParticle( particle_t *p )
 
 	if ( bp->dynamicLight && !( re.renderfx & RF_THIRD_PERSON ) )
 	{
-		trap_R_AddLightToScene( p->origin,
+		trap_R_AddLightToScene( origin,
 		                        CG_LerpValues( p->dLightRadius.initial, p->dLightRadius.final,
 		                            CG_CalculateTimeFrac( p->birthTime, p->lifeTime, p->dLightRadius.delay ) ),
 		                        3,
@@ -2684,9 +3327,66 @@ static void CG_RenderParticle( particle_t *p )
 		                        ( float ) bp->dLightColor[ 2 ] / ( float ) 0xFF, 0, 0 );
 	}
 
-	VectorCopy( p->origin, re.origin );
+	VectorCopy( origin, re.origin );
+
+	// sprites that are only seen in mirrors need the render flag of an entity, and batched quads
+	// only face the main view, so keep sprites as entities while a portal may draw another one
+	if ( re.reType == refEntityType_t::RT_SPRITE && !( re.renderfx & RF_THIRD_PERSON ) &&
+	     !bp->timedShaders && cg_batchParticles.integer && !cg.portalInScene )
+	{
+		CG_BatchSprite( &re );
+		return;
+	}
 
 	trap_R_AddRefEntityToScene( &re );
+	numParticleEntitySubmits++;
+}
+
+/*
+===============
+CG_FlushSpriteBatches
+
+Submits the collected sprite particles, a poly list for every run of the same
+shader. Without depth sorting the order doesn't matter and the sprites are
+grouped by shader first.
+===============
+*/
+static void CG_FlushSpriteBatches()
+{
+	int i, j;
+	int numParticleQuads = particleQuads.size();
+
+	particleQuadOrder.resize( numParticleQuads );
+	particleBatchVerts.resize( numParticleQuads * 4 );
+
+	for ( i = 0; i < numParticleQuads; i++ )
+	{
+		particleQuadOrder[ i ] = i;
+	}
+
+	if ( !cg_depthSortParticles.integer )
+	{
+		std::stable_sort( particleQuadOrder.begin(), particleQuadOrder.end(),
+		                  []( int a, int b ) { return particleQuads[ a ].shader < particleQuads[ b ].shader; } );
+	}
+
+	for ( i = 0; i < numParticleQuads; i = j )
+	{
+		qhandle_t shader = particleQuads[ particleQuadOrder[ i ] ].shader;
+		int       numVerts = 0;
+
+		for ( j = i; j < numParticleQuads && particleQuads[ particleQuadOrder[ j ] ].shader == shader; j++ )
+		{
+			memcpy( &particleBatchVerts[ numVerts ], particleQuads[ particleQuadOrder[ j ] ].verts,
+			        sizeof( particleQuads[ 0 ].verts ) );
+			numVerts += 4;
+		}
+
+		trap_R_AddPolysToScene( shader, 4, particleBatchVerts.data(), numVerts / 4 );
+		numParticleBatchSubmits++;
+	}
+
+	particleQuads.clear();
 }
 
 /*
@@ -2711,25 +3411,23 @@ void CG_AddParticles()
 	//sorting
 	CG_CompactAndSortParticles();
 
-	for ( i = 0; i < MAX_PARTICLES; i++ )
+	numParticleEntitySubmits = 0;
+	numParticleBatchSubmits = 0;
+
+	CG_EvaluateParticlePhysics();
+
+	for ( int slot : sortedParticles )
 	{
-		p = sortedParticles[ i ];
+		p = CG_Particle( slot );
 
 		if ( p->valid )
 		{
-			if ( p->birthTime + p->lifeTime > cg.time )
-			{
-				//particle is active
-				CG_EvaluateParticlePhysics( p );
-				CG_RenderParticle( p );
-			}
-			else
-			{
-				CG_DestroyParticle( p, nullptr );
-			}
+			CG_RenderParticle( p );
 		}
 	}
 
+	CG_FlushSpriteBatches();
+
 	if ( cg_debugParticles.integer >= 2 )
 	{
 		for ( i = 0; i < MAX_PARTICLE_SYSTEMS; i++ )
@@ -2748,15 +3446,17 @@ void CG_AddParticles()
 			}
 		}
 
-		for ( i = 0; i < MAX_PARTICLES; i++ )
+		for ( i = 0; i < numParticleSlots; i++ )
 		{
-			if ( particles[ i ].valid )
+			if ( CG_Particle( i )->valid )
 			{
 				numP++;
 			}
 		}
 
-		Log::Debug( "PS: %d  PE: %d  P: %d", numPS, numPE, numP );
+		Log::Debug( "PS: %d  PE: %d  P: %d  draws: %d (%d batches, %d entities)", numPS, numPE, numP,
+		            numParticleBatchSubmits + numParticleEntitySubmits,
+		            numParticleBatchSubmits, numParticleEntitySubmits );
 	}
 }
 
@@ -1561,6 +1561,16 @@ void CG_NewClientInfo( int clientNum )
 
 	CG_StatusMessages( &newInfo, ci );
 
+	// the team overlay is only sent when it changes, so keep what was received
+	if ( ci->infoValid )
+	{
+		newInfo.location = ci->location;
+		newInfo.health = ci->health;
+		newInfo.curWeaponClass = ci->curWeaponClass;
+		newInfo.credit = ci->credit;
+		newInfo.upgrade = ci->upgrade;
+	}
+
 	// replace whatever was there with the new one
 	newInfo.infoValid = true;
 	*ci = newInfo;
@@ -38,6 +38,27 @@ static  centity_t *cg_solidEntities[ MAX_ENTITIES_IN_SNAPSHOT ];
 static  int       cg_numTriggerEntities;
 static  centity_t *cg_triggerEntities[ MAX_ENTITIES_IN_SNAPSHOT ];
 
+// the solid entities split into brush models, which are always tested, and
+// boxes, which are sorted along x while predicting so that traces only test
+// the boxes they overlap; both refer to their place in cg_solidEntities so
+// that the entities are still tested in that order, which decides ties
+struct solidBox_t
+{
+	int       solidIndex;
+	vec3_t    mins, maxs;
+};
+
+static  int        cg_numSolidBModels;
+static  int        cg_solidBModels[ MAX_ENTITIES_IN_SNAPSHOT ];
+static  int        cg_numSolidBoxes;
+static  solidBox_t cg_solidBoxes[ MAX_ENTITIES_IN_SNAPSHOT ];
+static  float      cg_solidBoxesMaxWidth;
+static  bool       cg_solidBoxesSorted;
+
+// cg_debugTrace statistics of the current prediction
+static  int        cg_numTraces;
+static  int        cg_numTracesTested;
+
 /*
 ====================
 CG_BuildSolidList
@@ -57,6 +78,9 @@ void CG_BuildSolidList()
 
 	cg_numSolidEntities = 0;
 	cg_numTriggerEntities = 0;
+	cg_numSolidBModels = 0;
+	cg_numSolidBoxes = 0;
+	cg_solidBoxesSorted = false;
 
 	if ( cg.nextSnap && !cg.nextFrameTeleport && !cg.thisFrameTeleport )
 	{
@@ -95,8 +119,18 @@ void CG_BuildSolidList()
 					break;
 			}
 
+			if ( ent->solid == SOLID_BMODEL )
+			{
+				cg_solidBModels[ cg_numSolidBModels++ ] = cg_numSolidEntities;
+			}
+			else
+			{
+				cg_solidBoxes[ cg_numSolidBoxes++ ].solidIndex = cg_numSolidEntities;
+			}
+
 			cg_solidEntities[ cg_numSolidEntities ] = cent;
 			cg_numSolidEntities++;
+
 			continue;
 		}
 	}
@@ -104,140 +138,232 @@ void CG_BuildSolidList()
 
 /*
 ====================
-CG_ClipMoveToEntities
+CG_SortSolidBoxes
 
+Places the boxes of the solid list at their current positions and sorts
+them by their lowest x, the positions must not change until
+CG_ClipMoveToEntities is done with them
 ====================
 */
-static void CG_ClipMoveToEntities( const vec3_t start, const vec3_t mins,
-                                   const vec3_t maxs, const vec3_t end, int skipNumber,
-                                   int mask, int skipmask, trace_t *tr, traceType_t collisionType )
+static void CG_SortSolidBoxes()
+{
+	cg_solidBoxesMaxWidth = 0.0f;
+
+	for ( int i = 0; i < cg_numSolidBoxes; i++ )
+	{
+		solidBox_t    *box = &cg_solidBoxes[ i ];
+		centity_t     *cent = cg_solidEntities[ box->solidIndex ];
+		entityState_t *ent = &cent->currentState;
+
+		// the solid list is built from the next snapshot, so this may have changed since
+		if ( ent->solid == SOLID_BMODEL )
+		{
+			cg_solidBoxesSorted = false;
+			return;
+		}
+
+		// encoded bbox
+		int x = ( ent->solid & 255 );
+		int zd = ( ( ent->solid >> 8 ) & 255 );
+		int zu = ( ( ent->solid >> 16 ) & 255 ) - 32;
+
+		box->mins[ 0 ] = box->mins[ 1 ] = -x;
+		box->maxs[ 0 ] = box->maxs[ 1 ] = x;
+		box->mins[ 2 ] = -zd;
+		box->maxs[ 2 ] = zu;
+
+		VectorAdd( cent->lerpOrigin, box->mins, box->mins );
+		VectorAdd( cent->lerpOrigin, box->maxs, box->maxs );
+
+		cg_solidBoxesMaxWidth = std::max( cg_solidBoxesMaxWidth, box->maxs[ 0 ] - box->mins[ 0 ] );
+	}
+
+	std::sort( cg_solidBoxes, cg_solidBoxes + cg_numSolidBoxes,
+	           []( const solidBox_t &a, const solidBox_t &b ) { return a.mins[ 0 ] < b.mins[ 0 ]; } );
+
+	cg_solidBoxesSorted = true;
+}
+
+/*
+====================
+CG_ClipMoveToEntity
+
+Returns true when the trace can't get any shorter
+====================
+*/
+static bool CG_ClipMoveToEntity( centity_t *cent, const vec3_t start, const vec3_t mins,
+                                 const vec3_t maxs, const vec3_t end, const vec3_t tmins, const vec3_t tmaxs,
+                                 int skipNumber, int mask, int skipmask, trace_t *tr, traceType_t collisionType )
 {
-	int           i, x, zd, zu;
+	int           x, zd, zu;
 	trace_t       trace;
 	entityState_t *ent;
 	clipHandle_t  cmodel;
-	vec3_t        tmins, tmaxs;
 	vec3_t        bmins, bmaxs;
 	vec3_t        origin, angles;
-	centity_t     *cent;
 
-	// calculate bounding box of the trace
-	ClearBounds( tmins, tmaxs );
-	AddPointToBounds( start, tmins, tmaxs );
-	AddPointToBounds( end, tmins, tmaxs );
-	if( mins )
-		VectorAdd( mins, tmins, tmins );
-	if( maxs )
-		VectorAdd( maxs, tmaxs, tmaxs );
+	ent = &cent->currentState;
 
-	for ( i = 0; i < cg_numSolidEntities; i++ )
+	if ( ent->number == skipNumber )
 	{
-		if ( i < cg_numSolidEntities )
-		{
-			cent = cg_solidEntities[ i ];
-		}
-		else
-		{
-			cent = &cg.predictedPlayerEntity;
-		}
+		return false;
+	}
 
-		ent = &cent->currentState;
+	if ( !( cent->contents & mask ) )
+	{
+		return false;
+	}
 
-		if ( ent->number == skipNumber )
-		{
-			continue;
-		}
+	if ( cent->contents & skipmask )
+	{
+		return false;
+	}
 
-		if ( !( cent->contents & mask ) )
-		{
-			continue;
-		}
+	if ( ent->solid == SOLID_BMODEL )
+	{
+		// special value for bmodel
+		cmodel = trap_CM_InlineModel( ent->modelindex );
+		VectorCopy( cent->lerpAngles, angles );
+		BG_EvaluateTrajectory( &cent->currentState.pos, cg.physicsTime, origin );
+	}
+	else
+	{
+		// encoded bbox
+		x = ( ent->solid & 255 );
+		zd = ( ( ent->solid >> 8 ) & 255 );
+		zu = ( ( ent->solid >> 16 ) & 255 ) - 32;
 
-		if ( cent->contents & skipmask )
-		{
-			continue;
-		}
+		bmins[ 0 ] = bmins[ 1 ] = -x;
+		bmaxs[ 0 ] = bmaxs[ 1 ] = x;
+		bmins[ 2 ] = -zd;
+		bmaxs[ 2 ] = zu;
 
-		if ( ent->solid == SOLID_BMODEL )
-		{
-			// special value for bmodel
-			cmodel = trap_CM_InlineModel( ent->modelindex );
-			VectorCopy( cent->lerpAngles, angles );
-			BG_EvaluateTrajectory( &cent->currentState.pos, cg.physicsTime, origin );
-		}
-		else
-		{
-			// encoded bbox
-			x = ( ent->solid & 255 );
-			zd = ( ( ent->solid >> 8 ) & 255 );
-			zu = ( ( ent->solid >> 16 ) & 255 ) - 32;
+		VectorAdd( cent->lerpOrigin, bmins, bmins );
+		VectorAdd( cent->lerpOrigin, bmaxs, bmaxs );
 
-			bmins[ 0 ] = bmins[ 1 ] = -x;
-			bmaxs[ 0 ] = bmaxs[ 1 ] = x;
-			bmins[ 2 ] = -zd;
-			bmaxs[ 2 ] = zu;
+		if( !BoundsIntersect( bmins, bmaxs, tmins, tmaxs ) )
+			return false;
 
-			if ( i == cg_numSolidEntities )
-			{
-				BG_ClassBoundingBox( ( ent->misc >> 8 ) & 0xFF, bmins, bmaxs, nullptr, nullptr, nullptr );
-			}
+		cmodel = trap_CM_TempBoxModel( bmins, bmaxs );
+		VectorCopy( vec3_origin, angles );
+		VectorCopy( vec3_origin, origin );
+	}
 
-			VectorAdd( cent->lerpOrigin, bmins, bmins );
-			VectorAdd( cent->lerpOrigin, bmaxs, bmaxs );
+	cg_numTracesTested++;
 
-			if( !BoundsIntersect( bmins, bmaxs, tmins, tmaxs ) )
-				continue;
+	switch ( collisionType )
+	{
+	case traceType_t::TT_CAPSULE:
+		trap_CM_TransformedCapsuleTrace( &trace, start, end, mins, maxs, cmodel, mask, skipmask,
+		                                 origin, angles );
+		break;
+
+	case traceType_t::TT_AABB:
+		trap_CM_TransformedBoxTrace( &trace, start, end, mins, maxs, cmodel, mask, skipmask,
+		                             origin, angles );
+		break;
+
+	case traceType_t::TT_BISPHERE:
+		ASSERT(maxs != nullptr);
+		ASSERT(mins != nullptr);
+		trap_CM_TransformedBiSphereTrace( &trace, start, end, mins[ 0 ], maxs[ 0 ], cmodel,
+		                                  mask, skipmask, origin );
+		break;
+
+	default: // Shouldn't Happen
+		ASSERT(0);
+	}
 
-			cmodel = trap_CM_TempBoxModel( bmins, bmaxs );
-			VectorCopy( vec3_origin, angles );
-			VectorCopy( vec3_origin, origin );
-		}
+	if ( trace.allsolid || trace.fraction < tr->fraction )
+	{
+		trace.entityNum = ent->number;
 
-		switch ( collisionType )
+		if ( tr->lateralFraction < trace.lateralFraction )
+		{
+			float oldLateralFraction = tr->lateralFraction;
+			*tr = trace;
+			tr->lateralFraction = oldLateralFraction;
+		}
+		else
 		{
-		case traceType_t::TT_CAPSULE:
-			trap_CM_TransformedCapsuleTrace( &trace, start, end, mins, maxs, cmodel, mask, skipmask,
-			                                 origin, angles );
-			break;
+			*tr = trace;
+		}
+	}
+	else if ( trace.startsolid )
+	{
+		tr->startsolid = true;
+		tr->entityNum = ent->number;
+	}
 
-		case traceType_t::TT_AABB:
-			trap_CM_TransformedBoxTrace( &trace, start, end, mins, maxs, cmodel, mask, skipmask,
-			                             origin, angles );
-			break;
+	return tr->allsolid;
+}
 
-		case traceType_t::TT_BISPHERE:
-			ASSERT(maxs != nullptr);
-			ASSERT(mins != nullptr);
-			trap_CM_TransformedBiSphereTrace( &trace, start, end, mins[ 0 ], maxs[ 0 ], cmodel,
-			                                  mask, skipmask, origin );
-			break;
+/*
+====================
+CG_ClipMoveToEntities
 
-		default: // Shouldn't Happen
-			ASSERT(0);
-		}
+====================
+*/
+static void CG_ClipMoveToEntities( const vec3_t start, const vec3_t mins,
+                                   const vec3_t maxs, const vec3_t end, int skipNumber,
+                                   int mask, int skipmask, trace_t *tr, traceType_t collisionType )
+{
+	int    i;
+	vec3_t tmins, tmaxs;
+	int    numCandidates = 0;
+	int    candidates[ MAX_ENTITIES_IN_SNAPSHOT ];
 
-		if ( trace.allsolid || trace.fraction < tr->fraction )
-		{
-			trace.entityNum = ent->number;
+	// calculate bounding box of the trace
+	ClearBounds( tmins, tmaxs );
+	AddPointToBounds( start, tmins, tmaxs );
+	AddPointToBounds( end, tmins, tmaxs );
+	if( mins )
+		VectorAdd( mins, tmins, tmins );
+	if( maxs )
+		VectorAdd( maxs, tmaxs, tmaxs );
 
-			if ( tr->lateralFraction < trace.lateralFraction )
-			{
-				float oldLateralFraction = tr->lateralFraction;
-				*tr = trace;
-				tr->lateralFraction = oldLateralFraction;
-			}
-			else
+	cg_numTraces++;
+
+	if ( !cg_solidBoxesSorted )
+	{
+		for ( i = 0; i < cg_numSolidEntities; i++ )
+		{
+			if ( CG_ClipMoveToEntity( cg_solidEntities[ i ], start, mins, maxs, end, tmins, tmaxs,
+			                          skipNumber, mask, skipmask, tr, collisionType ) )
 			{
-				*tr = trace;
+				return;
 			}
 		}
-		else if ( trace.startsolid )
+
+		return;
+	}
+
+	for ( i = 0; i < cg_numSolidBModels; i++ )
+	{
+		candidates[ numCandidates++ ] = cg_solidBModels[ i ];
+	}
+
+	// no box starting further left than the widest one can reach the trace
+	float lowest = tmins[ 0 ] - cg_solidBoxesMaxWidth;
+	solidBox_t *box = std::lower_bound( cg_solidBoxes, cg_solidBoxes + cg_numSolidBoxes, lowest,
+	                  []( const solidBox_t &b, float x ) { return b.mins[ 0 ] < x; } );
+
+	for ( ; box < cg_solidBoxes + cg_numSolidBoxes && box->mins[ 0 ] <= tmaxs[ 0 ]; box++ )
+	{
+		if ( BoundsIntersect( box->mins, box->maxs, tmins, tmaxs ) )
 		{
-			tr->startsolid = true;
-			tr->entityNum = ent->number;
+			candidates[ numCandidates++ ] = box->solidIndex;
 		}
+	}
+
+	// the sorting only culls, the entities that are left are tested in the
+	// order of the solid list like the unsorted path does
+	std::sort( candidates, candidates + numCandidates );
 
-		if ( tr->allsolid )
+	for ( i = 0; i < numCandidates; i++ )
+	{
+		if ( CG_ClipMoveToEntity( cg_solidEntities[ candidates[ i ] ], start, mins, maxs, end, tmins, tmaxs,
+		                          skipNumber, mask, skipmask, tr, collisionType ) )
 		{
 			return;
 		}
@@ -752,6 +878,11 @@ void CG_PredictPlayerState()
 	// get the latest command so we can know which commands are from previous map_restarts
 	trap_GetUserCmd( current, &latestCmd );
 
+	// the other entities don't move while we predict, so let traces look them up by position
+	CG_SortSolidBoxes();
+	cg_numTraces = 0;
+	cg_numTracesTested = 0;
+
 	// get the most recent information we have, even if
 	// the server time is beyond our current cg.time,
 	// because predicted player positions are going to
@@ -1012,6 +1143,14 @@ void CG_PredictPlayerState()
 		//CG_CheckChangedPredictableEvents(&cg.predictedPlayerState);
 	}
 
+	cg_solidBoxesSorted = false;
+
+	if ( cg_debugTrace.integer && cg_numTraces )
+	{
+		Log::Notice( "prediction: %d traces, %.1f of %d solid entities tested per trace",
+		             cg_numTraces, ( float ) cg_numTracesTested / cg_numTraces, cg_numSolidEntities );
+	}
+
 	// adjust for the movement of the groundentity
 	CG_AdjustPositionForMover( cg.predictedPlayerState.origin,
 	                           cg.predictedPlayerState.groundEntityNum,
@@ -78,6 +78,129 @@ static void CG_ParseScores()
 		cg.scores[ i ].team = cgs.clientinfo[ cg.scores[ i ].client ].team;
 	}
 
+	cg.scoresReceived = true;
+	cg.scoresRequested = false;
+	cg.scoreInvalidated = true;
+}
+
+/*
+=================
+CG_RequestFullScores
+
+Asks for a whole scoreboard, unless one is already on its way
+=================
+*/
+static void CG_RequestFullScores()
+{
+	cg.scoresReceived = false;
+
+	if ( !cg.scoresRequested )
+	{
+		trap_SendClientCommand( "score full\n" );
+		cg.scoresRequested = true;
+	}
+}
+
+/*
+=================
+CG_ParseScoresDelta
+
+Applies the changes to the scoreboard received last, see ScoreboardMessage
+=================
+*/
+static void CG_ParseScoresDelta()
+{
+	int         i, j;
+	int         count;
+	const char  *order;
+	score_t     scores[ MAX_CLIENTS ];
+	int         numScores;
+
+	// we can't apply the changes to something we don't have, so ask for everything
+	if ( !cg.scoresReceived )
+	{
+		CG_RequestFullScores();
+		return;
+	}
+
+	cg.teamScores[ 0 ] = atoi( CG_Argv( 1 ) );
+	cg.teamScores[ 1 ] = atoi( CG_Argv( 2 ) );
+
+	order = CG_Argv( 3 );
+
+	if ( order[ 0 ] == 'o' )
+	{
+		int length = strlen( order + 1 ) / 2;
+
+		memset( scores, 0, sizeof( scores ) );
+		numScores = 0;
+
+		for ( i = 0; i < length && numScores < MAX_CLIENTS; i++ )
+		{
+			char hex[ 3 ] = { order[ 1 + i * 2 ], order[ 2 + i * 2 ], '\0' };
+			int  client = strtol( hex, nullptr, 16 );
+
+			if ( client < 0 || client >= MAX_CLIENTS )
+			{
+				continue;
+			}
+
+			scores[ numScores ].client = client;
+
+			// keep what we already know about clients that only moved
+			for ( j = 0; j < cg.numScores; j++ )
+			{
+				if ( cg.scores[ j ].client == client )
+				{
+					scores[ numScores ] = cg.scores[ j ];
+					break;
+				}
+			}
+
+			numScores++;
+		}
+
+		memcpy( cg.scores, scores, sizeof( cg.scores ) );
+		cg.numScores = numScores;
+	}
+
+	count = trap_Argc();
+
+	for ( i = 4; i + 1 < count; )
+	{
+		int     client = atoi( CG_Argv( i++ ) );
+		int     mask = atoi( CG_Argv( i++ ) );
+		score_t *score = nullptr;
+
+		for ( j = 0; j < cg.numScores; j++ )
+		{
+			if ( cg.scores[ j ].client == client )
+			{
+				score = &cg.scores[ j ];
+				break;
+			}
+		}
+
+		if ( !score )
+		{
+			Log::Warn( S_SKIPNOTIFY "CG_ParseScoresDelta: client %d isn't on the scoreboard", client );
+			CG_RequestFullScores();
+			return;
+		}
+
+		if ( mask & 1 )  score->score = atoi( CG_Argv( i++ ) );
+		if ( mask & 2 )  score->ping = atoi( CG_Argv( i++ ) );
+		if ( mask & 4 )  score->time = atoi( CG_Argv( i++ ) );
+		if ( mask & 8 )  score->weapon = (weapon_t) atoi( CG_Argv( i++ ) );
+		if ( mask & 16 ) score->upgrade = (upgrade_t) atoi( CG_Argv( i++ ) );
+	}
+
+	for ( i = 0; i < cg.numScores; i++ )
+	{
+		cgs.clientinfo[ cg.scores[ i ].client ].score = cg.scores[ i ].score;
+		cg.scores[ i ].team = cgs.clientinfo[ cg.scores[ i ].client ].team;
+	}
+
 	cg.scoreInvalidated = true;
 }
 
@@ -125,6 +248,46 @@ static void CG_ParseTeamInfo()
 	cgs.teamInfoReceived = true;
 }
 
+/*
+=================
+CG_ParseTeamInfoDelta
+
+Every entry is a client number, a mask of the fields that changed and their values,
+see TeamplayInfoMessage
+=================
+*/
+static void CG_ParseTeamInfoDelta()
+{
+	int i;
+	int count;
+	int client;
+	int mask;
+
+	count = trap_Argc();
+
+	for ( i = 1; i + 1 < count; )
+	{
+		client = atoi( CG_Argv( i++ ) );
+		mask = atoi( CG_Argv( i++ ) );
+
+		if ( client < 0 || client >= MAX_CLIENTS )
+		{
+			Log::Warn( S_SKIPNOTIFY "CG_ParseTeamInfoDelta: bad client number: %d", client );
+			return;
+		}
+
+		// unlike with full updates the fields of other teams are kept as well,
+		// the server won't send them again if they don't change
+		if ( mask & 1 )  cgs.clientinfo[ client ].location       = atoi( CG_Argv( i++ ) );
+		if ( mask & 2 )  cgs.clientinfo[ client ].health         = atoi( CG_Argv( i++ ) );
+		if ( mask & 4 )  cgs.clientinfo[ client ].curWeaponClass = atoi( CG_Argv( i++ ) );
+		if ( mask & 8 )  cgs.clientinfo[ client ].credit         = atoi( CG_Argv( i++ ) );
+		if ( mask & 16 ) cgs.clientinfo[ client ].upgrade        = atoi( CG_Argv( i++ ) );
+	}
+
+	cgs.teamInfoReceived = true;
+}
+
 /*
 ================
 CG_ParseServerinfo
@@ -1347,10 +1510,12 @@ static const consoleCommand_t svcommands[] =
 	{ "print",            CG_Print_f              },
 	{ "print_tr",         CG_PrintTR_f            },
 	{ "print_tr_p",       CG_PrintTR_plural_f     },
+	{ "scored",           CG_ParseScoresDelta     },
 	{ "scores",           CG_ParseScores          },
 	{ "serverclosemenus", CG_ServerCloseMenus_f   },
 	{ "servermenu",       CG_ServerMenu_f         },
 	{ "tinfo",            CG_ParseTeamInfo        },
+	{ "tinfod",           CG_ParseTeamInfoDelta   },
 	{ "vcommand",         CG_VCommand             },
 	{ "voice",            CG_ParseVoice           }
 };
@@ -32,6 +32,9 @@ static baseTrailBeam_t   baseTrailBeams[ MAX_BASETRAIL_BEAMS ];
 static int               numBaseTrailSystems = 0;
 static int               numBaseTrailBeams = 0;
 
+// base trail systems by lower case name
+static std::unordered_map<std::string, int> baseTrailSystemIndex;
+
 static trailSystem_t     trailSystems[ MAX_TRAIL_SYSTEMS ];
 static trailBeam_t       trailBeams[ MAX_TRAIL_BEAMS ];
 
@@ -1194,6 +1197,25 @@ static bool CG_ParseTrailSystem( baseTrailSystem_t *bts, const char **text_p, co
 	return false;
 }
 
+/*
+===============
+CG_FindBaseTrailSystem
+
+Returns the index of the base trail system with that name, or -1
+===============
+*/
+static int CG_FindBaseTrailSystem( const char *name )
+{
+	auto it = baseTrailSystemIndex.find( CG_LowercaseKey( name ) );
+
+	return it == baseTrailSystemIndex.end() ? -1 : it->second;
+}
+
+static void CG_IndexBaseTrailSystem( int index )
+{
+	baseTrailSystemIndex[ CG_LowercaseKey( baseTrailSystems[ index ].name ) ] = index;
+}
+
 /*
 ===============
 CG_ParseTrailFile
@@ -1204,7 +1226,6 @@ Load the trail systems from a trail file
 static bool CG_ParseTrailFile( const char *fileName )
 {
 	const char         *text_p;
-	int          i;
 	int          len;
 	char         *token;
 	char         text[ 32000 ];
@@ -1249,13 +1270,10 @@ static bool CG_ParseTrailFile( const char *fileName )
 			if ( tsNameSet )
 			{
 				//check for name space clashes
-				for ( i = 0; i < numBaseTrailSystems; i++ )
+				if ( CG_FindBaseTrailSystem( tsName ) >= 0 )
 				{
-					if ( !Q_stricmp( baseTrailSystems[ i ].name, tsName ) )
-					{
-						Log::Warn( "a trail system is already named %s", tsName );
-						return false;
-					}
+					Log::Warn( "a trail system is already named %s", tsName );
+					return false;
 				}
 
 				Q_strncpyz( baseTrailSystems[ numBaseTrailSystems ].name, tsName, MAX_QPATH );
@@ -1277,6 +1295,7 @@ static bool CG_ParseTrailFile( const char *fileName )
 				}
 				else
 				{
+					CG_IndexBaseTrailSystem( numBaseTrailSystems );
 					numBaseTrailSystems++;
 				}
 
@@ -1304,41 +1323,161 @@ static bool CG_ParseTrailFile( const char *fileName )
 	return true;
 }
 
+static void CG_ClearBaseTrailSystems()
+{
+	numBaseTrailSystems = 0;
+	numBaseTrailBeams = 0;
+	baseTrailSystemIndex.clear();
+
+	memset( baseTrailSystems, 0, sizeof( baseTrailSystems ) );
+	memset( baseTrailBeams, 0, sizeof( baseTrailBeams ) );
+}
+
+// changes whenever the cached structures do
+#define TRAIL_CACHE_LAYOUT { sizeof( baseTrailBeam_t ), sizeof( baseTrailSystem_t ) }
+
 /*
 ===============
-CG_LoadTrailSystems
+CG_SaveTrailCache
 
-Load trail system templates
+Saves the parsed base trail systems, with their beams stored as indices.
 ===============
 */
-void CG_LoadTrailSystems()
+static void CG_SaveTrailCache( uint64_t key )
 {
-	int  i, numFiles, fileLen;
-	char fileList[ MAX_TRAIL_FILES * MAX_QPATH ];
-	char fileName[ MAX_QPATH ];
-	char *filePtr;
+	std::vector<byte> data;
 
-	//clear out the old
-	numBaseTrailSystems = 0;
-	numBaseTrailBeams = 0;
+	CG_AssetCacheWrite( data, &numBaseTrailBeams, sizeof( numBaseTrailBeams ) );
+	CG_AssetCacheWrite( data, &numBaseTrailSystems, sizeof( numBaseTrailSystems ) );
+
+	CG_AssetCacheWrite( data, baseTrailBeams, numBaseTrailBeams * sizeof( baseTrailBeam_t ) );
 
-	for ( i = 0; i < MAX_BASETRAIL_SYSTEMS; i++ )
+	for ( int i = 0; i < numBaseTrailSystems; i++ )
+	{
+		const baseTrailSystem_t *bts = &baseTrailSystems[ i ];
+
+		CG_AssetCacheWrite( data, bts, sizeof( *bts ) );
+
+		for ( int j = 0; j < bts->numBeams; j++ )
+		{
+			int index = bts->beams[ j ] - baseTrailBeams;
+			CG_AssetCacheWrite( data, &index, sizeof( index ) );
+		}
+	}
+
+	CG_SaveAssetCache( "trails", key, data );
+}
+
+static bool CG_ReadTrailCache( const std::vector<byte> &data )
+{
+	size_t pos = 0;
+
+	if ( !CG_AssetCacheRead( data, pos, &numBaseTrailBeams, sizeof( numBaseTrailBeams ) ) ||
+	     !CG_AssetCacheRead( data, pos, &numBaseTrailSystems, sizeof( numBaseTrailSystems ) ) )
+	{
+		return false;
+	}
+
+	if ( numBaseTrailBeams < 0 || numBaseTrailBeams > MAX_BASETRAIL_BEAMS ||
+	     numBaseTrailSystems < 0 || numBaseTrailSystems > MAX_BASETRAIL_SYSTEMS )
+	{
+		return false;
+	}
+
+	if ( !CG_AssetCacheRead( data, pos, baseTrailBeams, numBaseTrailBeams * sizeof( baseTrailBeam_t ) ) )
+	{
+		return false;
+	}
+
+	for ( int i = 0; i < numBaseTrailSystems; i++ )
 	{
 		baseTrailSystem_t *bts = &baseTrailSystems[ i ];
-		memset( bts, 0, sizeof( baseTrailSystem_t ) );
+
+		if ( !CG_AssetCacheRead( data, pos, bts, sizeof( *bts ) ) ||
+		     bts->numBeams < 0 || bts->numBeams > MAX_BEAMS_PER_SYSTEM )
+		{
+			return false;
+		}
+
+		// the pointers were saved as they were in the process that wrote the cache
+		memset( bts->beams, 0, sizeof( bts->beams ) );
+
+		for ( int j = 0; j < bts->numBeams; j++ )
+		{
+			int index;
+
+			if ( !CG_AssetCacheRead( data, pos, &index, sizeof( index ) ) ||
+			     index < 0 || index >= numBaseTrailBeams )
+			{
+				return false;
+			}
+
+			bts->beams[ j ] = &baseTrailBeams[ index ];
+		}
+
+		CG_IndexBaseTrailSystem( i );
 	}
 
-	for ( i = 0; i < MAX_BASETRAIL_BEAMS; i++ )
+	return pos == data.size();
+}
+
+/*
+===============
+CG_LoadTrailCache
+
+Loads the base trail systems from the asset cache instead of parsing the
+.trail files, if it is up to date.
+===============
+*/
+static bool CG_LoadTrailCache( uint64_t key )
+{
+	std::vector<byte> data;
+
+	if ( !CG_LoadAssetCache( "trails", key, data ) )
 	{
-		baseTrailBeam_t *btb = &baseTrailBeams[ i ];
-		memset( btb, 0, sizeof( baseTrailBeam_t ) );
+		return false;
 	}
 
+	if ( !CG_ReadTrailCache( data ) )
+	{
+		Log::Warn( "trail cache is invalid, parsing the trail files" );
+		CG_ClearBaseTrailSystems();
+		return false;
+	}
+
+	return true;
+}
+
+/*
+===============
+CG_LoadTrailSystems
+
+Load trail system templates
+===============
+*/
+void CG_LoadTrailSystems()
+{
+	int      i, numFiles, fileLen;
+	char     fileList[ MAX_TRAIL_FILES * MAX_QPATH ];
+	char     fileName[ MAX_QPATH ];
+	char     *filePtr;
+	uint64_t cacheKey;
+
+	//clear out the old
+	CG_ClearBaseTrailSystems();
+
 	//and bring in the new
 	numFiles = trap_FS_GetFileList( "scripts", ".trail",
 	                                fileList, MAX_TRAIL_FILES * MAX_QPATH );
 	filePtr = fileList;
 
+	cacheKey = CG_AssetCacheKey( "scripts", fileList, numFiles, TRAIL_CACHE_LAYOUT );
+
+	if ( CG_LoadTrailCache( cacheKey ) )
+	{
+		return;
+	}
+
 	for ( i = 0; i < numFiles; i++, filePtr += fileLen + 1 )
 	{
 		fileLen = strlen( filePtr );
@@ -1347,6 +1486,8 @@ void CG_LoadTrailSystems()
 		// Log::Notice(_( "...loading '%s'"), fileName );
 		CG_ParseTrailFile( fileName );
 	}
+
+	CG_SaveTrailCache( cacheKey );
 }
 
 /*
@@ -1362,40 +1503,39 @@ qhandle_t CG_RegisterTrailSystem( const char *name )
 	baseTrailSystem_t *bts;
 	baseTrailBeam_t   *btb;
 
-	for ( i = 0; i < MAX_BASETRAIL_SYSTEMS; i++ )
-	{
-		bts = &baseTrailSystems[ i ];
+	i = CG_FindBaseTrailSystem( name );
 
-		if ( !Q_stricmp( bts->name, name ) )
-		{
-			//already registered
-			if ( bts->registered )
-			{
-				return i + 1;
-			}
+	if ( i < 0 )
+	{
+		Log::Warn( "failed to register trail system %s", name );
+		return 0;
+	}
 
-			for ( j = 0; j < bts->numBeams; j++ )
-			{
-				btb = bts->beams[ j ];
+	bts = &baseTrailSystems[ i ];
 
-				btb->shader = trap_R_RegisterShader(btb->shaderName,
-								    RSF_DEFAULT);
-			}
+	//already registered
+	if ( bts->registered )
+	{
+		return i + 1;
+	}
 
-			if ( cg_debugTrails.integer >= 1 )
-			{
-				Log::Debug( "Registered trail system %s", name );
-			}
+	for ( j = 0; j < bts->numBeams; j++ )
+	{
+		btb = bts->beams[ j ];
 
-			bts->registered = true;
+		btb->shader = trap_R_RegisterShader(btb->shaderName,
+						    RSF_DEFAULT);
+	}
 
-			//avoid returning 0
-			return i + 1;
-		}
+	if ( cg_debugTrails.integer >= 1 )
+	{
+		Log::Debug( "Registered trail system %s", name );
 	}
 
-	Log::Warn( "failed to register trail system %s", name );
-	return 0;
+	bts->registered = true;
+
+	//avoid returning 0
+	return i + 1;
 }
 
 /*
@@ -227,3 +227,16 @@ void CG_SetKeyCatcher( int catcher )
 	Rocket_SetActiveContext( catcher );
 	trap_Key_SetCatcher( catcher );
 }
+
+// the key under which a case-insensitive name is indexed
+std::string CG_LowercaseKey( const char *name )
+{
+	std::string key = name;
+
+	for ( char &c : key )
+	{
+		c = Str::ctolower( c );
+	}
+
+	return key;
+}
@@ -1264,6 +1264,183 @@ static void CG_smoothWJTransitions( playerState_t *ps, const vec3_t in, vec3_t o
 	}
 }
 
+/*
+==============================================================================
+
+VOLUME DISTANCE CACHE
+
+The weights of the color gradings and reverb effects of a map depend on the
+distance of the view to their volumes. Instead of asking the engine for every
+distance on every frame, distances are sampled on the points of a coarse grid
+when a cell is first visited and interpolated inside the cell.
+
+The distance to a model changes at most as much as the point it is measured
+from moves, so the samples at the corners of a cell also bound the distance
+anywhere in it. Volumes that are surely further away than their fade distance
+are skipped, and only close to a volume, where the distance isn't smooth, the
+exact distance is asked for.
+
+==============================================================================
+*/
+
+#define VOLUME_CELL_SIZE   64.0f
+#define VOLUME_NUM_SLOTS   ( MAX_GRADING_TEXTURES + MAX_REVERB_EFFECTS )
+#define VOLUME_MAX_SAMPLES 4096 // the cache starts over when it holds more
+
+// the distances of a grid point to the volume of every slot, negative if not sampled yet
+struct volumeSample_t
+{
+	float distances[ VOLUME_NUM_SLOTS ];
+};
+
+static std::unordered_map<uint64_t, volumeSample_t> volumeSamples;
+
+// the last exact distance of every slot, for views that don't move
+static struct
+{
+	vec3_t loc;
+	float  distance;
+	bool   valid;
+} volumeExact[ VOLUME_NUM_SLOTS ];
+
+/*
+===============
+CG_ClearVolumeCache
+
+Forgets all sampled distances, needed whenever a volume changes.
+===============
+*/
+void CG_ClearVolumeCache()
+{
+	volumeSamples.clear();
+	memset( volumeExact, 0, sizeof( volumeExact ) );
+}
+
+static float CG_VolumeSampleDistance( const int point[ 3 ], int slot, qhandle_t model )
+{
+	// grid coordinates fit into 21 bits each for any map size
+	uint64_t key = ( ( uint64_t )( point[ 0 ] + ( 1 << 20 ) ) << 42 ) |
+	               ( ( uint64_t )( point[ 1 ] + ( 1 << 20 ) ) << 21 ) |
+	               ( uint64_t )( point[ 2 ] + ( 1 << 20 ) );
+
+	auto it = volumeSamples.find( key );
+
+	if ( it == volumeSamples.end() )
+	{
+		if ( volumeSamples.size() >= VOLUME_MAX_SAMPLES )
+		{
+			volumeSamples.clear();
+		}
+
+		volumeSample_t sample;
+
+		for ( float &distance : sample.distances )
+		{
+			distance = -1.0f;
+		}
+
+		it = volumeSamples.emplace( key, sample ).first;
+	}
+
+	float &distance = it->second.distances[ slot ];
+
+	if ( distance < 0.0f )
+	{
+		vec3_t origin;
+
+		VectorSet( origin, point[ 0 ] * VOLUME_CELL_SIZE, point[ 1 ] * VOLUME_CELL_SIZE,
+		           point[ 2 ] * VOLUME_CELL_SIZE );
+		distance = trap_CM_DistanceToModel( origin, model );
+	}
+
+	return distance;
+}
+
+static float CG_VolumeExactDistance( const vec3_t loc, int slot, qhandle_t model )
+{
+	if ( !volumeExact[ slot ].valid || !VectorCompare( loc, volumeExact[ slot ].loc ) )
+	{
+		VectorCopy( loc, volumeExact[ slot ].loc );
+		volumeExact[ slot ].distance = trap_CM_DistanceToModel( loc, model );
+		volumeExact[ slot ].valid = true;
+	}
+
+	return volumeExact[ slot ].distance;
+}
+
+/*
+===============
+CG_VolumeDistance
+
+Returns the distance of loc to the model of a volume slot, good enough to
+compute the weight of the volume with: it may be anything not less than
+fadeDistance when the volume is surely out of reach.
+===============
+*/
+static float CG_VolumeDistance( const vec3_t loc, int slot, qhandle_t model, float fadeDistance )
+{
+	int   cell[ 3 ];
+	float frac[ 3 ];
+	float lower = 0.0f, upper = FLT_MAX;
+	float nearest = FLT_MAX;
+	float interpolated = 0.0f;
+
+	// keep the original behaviour for global volumes and invalid fade distances
+	if ( !cg_volumeCache.integer || model <= 0 || fadeDistance <= 0.0f )
+	{
+		return trap_CM_DistanceToModel( loc, model );
+	}
+
+	for ( int i = 0; i < 3; i++ )
+	{
+		float f = loc[ i ] / VOLUME_CELL_SIZE;
+
+		cell[ i ] = ( int ) floorf( f );
+		frac[ i ] = f - cell[ i ];
+	}
+
+	for ( int corner = 0; corner < 8; corner++ )
+	{
+		int    point[ 3 ];
+		vec3_t origin;
+		float  weight = 1.0f;
+
+		for ( int i = 0; i < 3; i++ )
+		{
+			int offset = ( corner >> i ) & 1;
+
+			point[ i ] = cell[ i ] + offset;
+			weight *= offset ? frac[ i ] : 1.0f - frac[ i ];
+		}
+
+		float distance = CG_VolumeSampleDistance( point, slot, model );
+		float gap;
+
+		VectorSet( origin, point[ 0 ] * VOLUME_CELL_SIZE, point[ 1 ] * VOLUME_CELL_SIZE,
+		           point[ 2 ] * VOLUME_CELL_SIZE );
+		gap = Distance( loc, origin );
+
+		lower = std::max( lower, distance - gap );
+		upper = std::min( upper, distance + gap );
+		nearest = std::min( nearest, distance );
+		interpolated += weight * distance;
+	}
+
+	if ( lower >= fadeDistance )
+	{
+		return lower;
+	}
+
+	// the volume may reach into the cell
+	if ( nearest < VOLUME_CELL_SIZE * 2.0f )
+	{
+		return CG_VolumeExactDistance( loc, slot, model );
+	}
+
+	// rounding may let the bounds cross
+	return std::min( std::max( interpolated, lower ), upper );
+}
+
 /*
 ===============
 CG_CalcColorGradingForPoint
@@ -1299,7 +1476,7 @@ static void CG_CalcColorGradingForPoint( vec3_t loc )
 			continue;
 		}
 
-		dist = trap_CM_DistanceToModel( loc, cgs.gameGradingModels[i] );
+		dist = CG_VolumeDistance( loc, i, cgs.gameGradingModels[i], cgs.gameGradingDistances[i] );
 		weight = 1.0f - dist / cgs.gameGradingDistances[i];
 		weight = Math::Clamp( weight, 0.0f, 1.0f ); // Maths::clampFraction( weight )
 
@@ -1492,7 +1669,7 @@ static void CG_AddReverbEffects( vec3_t loc )
 			continue;
 		}
 
-		dist = trap_CM_DistanceToModel( loc, cgs.gameReverbModels[i] );
+		dist = CG_VolumeDistance( loc, MAX_GRADING_TEXTURES + i, cgs.gameReverbModels[i], cgs.gameReverbDistances[i] );
 		weight = 1.0f - dist / cgs.gameReverbDistances[i];
 		weight = Math::Clamp( weight, 0.0f, 1.0f ); // Maths::clampFraction( weight )
 
@@ -116,12 +116,11 @@ float Entities::HealthFraction(gentity_t* ent) {
 bool Entities::AntiHumanRadiusDamage(Entity& entity, float amount, float range, meansOfDeath_t mod) {
 	bool hit = false;
 
-	ForEntities<HumanClassComponent>([&] (Entity& other, HumanClassComponent& humanClassComponent) {
-		// TODO: Add LocationComponent.
+	ForEntitiesInRadius<HumanClassComponent>(Vec3::Load(entity.oldEnt->s.origin), range,
+	                                         [&] (Entity& other, HumanClassComponent& humanClassComponent) {
 		float distance = G_Distance(entity.oldEnt, other.oldEnt);
 		float damage   = amount * (1.0f - 0.7f * distance / range);
 
-		if (distance > range) return;
 		if (damage <= 0.0f) return;
 		if (!G_IsVisible(entity.oldEnt, other.oldEnt, MASK_SOLID)) return;
 
@@ -137,9 +136,8 @@ bool Entities::KnockbackRadiusDamage(Entity& entity, float amount, float range,
 	bool hit = false;
 
 	// FIXME: Only considering entities with HealthComponent.
-	// TODO: Allow ForEntities to iterate over all entities.
-	ForEntities<HealthComponent>([&] (Entity& other, HealthComponent& healthComponent) {
-		// TODO: Add LocationComponent.
+	ForEntitiesInRadius<HealthComponent>(Vec3::Load(entity.oldEnt->s.origin), range,
+	                                     [&] (Entity& other, HealthComponent& healthComponent) {
 		float distance = G_Distance(entity.oldEnt, other.oldEnt);
 		float damage   = amount * (1.0f - distance / range);
 
@@ -28,10 +28,8 @@ void AlienBuildableComponent::Think(int timeDelta) {
 	float creepSize = (float)BG_Buildable((buildable_t)entity.oldEnt->s.modelindex)->creepSize;
 
 	// Slow close humans.
-	ForEntities<HumanClassComponent>([&] (Entity& other, HumanClassComponent& humanClassComponent) {
-		// TODO: Add LocationComponent.
-		if (G_Distance(entity.oldEnt, other.oldEnt) > creepSize) return;
-
+	ForEntitiesInRadius<HumanClassComponent>(GetBuildableComponent().GetLocationComponent().Origin(), creepSize,
+	                                         [&] (Entity& other, HumanClassComponent& humanClassComponent) {
 		// TODO: Send (Creep)Slow message instead.
 		if (other.oldEnt->flags & FL_NOTARGET) return;
 		if (other.oldEnt->client->ps.groundEntityNum == ENTITYNUM_NONE) return;
@@ -1,8 +1,10 @@
 #include "BuildableComponent.h"
 
 BuildableComponent::BuildableComponent(Entity& entity, HealthComponent& r_HealthComponent,
-	ThinkingComponent& r_ThinkingComponent, TeamComponent& r_TeamComponent)
-	: BuildableComponentBase(entity, r_HealthComponent, r_ThinkingComponent, r_TeamComponent)
+	ThinkingComponent& r_ThinkingComponent, TeamComponent& r_TeamComponent,
+	LocationComponent& r_LocationComponent)
+	: BuildableComponentBase(entity, r_HealthComponent, r_ThinkingComponent, r_TeamComponent,
+	                         r_LocationComponent)
 	, state(CONSTRUCTING)
 	, constructionHasFinished(false)
 	, marked(false) {
@@ -25,9 +25,10 @@ class BuildableComponent: public BuildableComponentBase {
 		 * @param r_HealthComponent A HealthComponent instance that this component depends on.
 		 * @param r_ThinkingComponent A ThinkingComponent instance that this component depends on.
 		 * @param r_TeamComponent A TeamComponent instance that this component depends on.
+		 * @param r_LocationComponent A LocationComponent instance that this component depends on.
 		 * @note This method is an interface for autogenerated code, do not modify its signature.
 		 */
-		BuildableComponent(Entity& entity, HealthComponent& r_HealthComponent, ThinkingComponent& r_ThinkingComponent, TeamComponent& r_TeamComponent);
+		BuildableComponent(Entity& entity, HealthComponent& r_HealthComponent, ThinkingComponent& r_ThinkingComponent, TeamComponent& r_TeamComponent, LocationComponent& r_LocationComponent);
 
 		/**
 		 * @brief Handle the PrepareNetCode message.
@@ -1,5 +1,6 @@
 #include "ClientComponent.h"
 
-ClientComponent::ClientComponent(Entity& entity, gclient_t* clientData, TeamComponent& r_TeamComponent)
-	: ClientComponentBase(entity, clientData, r_TeamComponent)
+ClientComponent::ClientComponent(Entity& entity, gclient_t* clientData, TeamComponent& r_TeamComponent,
+	LocationComponent& r_LocationComponent)
+	: ClientComponentBase(entity, clientData, r_TeamComponent, r_LocationComponent)
 {}
@@ -16,9 +16,10 @@ class ClientComponent: public ClientComponentBase {
 		 * @param entity The entity that owns the component instance.
 		 * @param clientData An initialization parameter.
 		 * @param r_TeamComponent A TeamComponent instance that this component depends on.
+		 * @param r_LocationComponent A LocationComponent instance that this component depends on.
 		 * @note This method is an interface for autogenerated code, do not modify its signature.
 		 */
-		ClientComponent(Entity& entity, gclient_t* clientData, TeamComponent& r_TeamComponent);
+		ClientComponent(Entity& entity, gclient_t* clientData, TeamComponent& r_TeamComponent, LocationComponent& r_LocationComponent);
 
 
 		// ///////////////////// //
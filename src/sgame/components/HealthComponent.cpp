@@ -209,9 +209,8 @@ Util::optional<Vec3> direction, int flags, meansOfDeath_t meansOfDeath) {
 		if (source->client) {
 			// Add to the attacker's account on the target.
 			// TODO: Move damage account array to HealthComponent.
-			entity.oldEnt->credits[source->client->ps.clientNum].value += loss;
-			entity.oldEnt->credits[source->client->ps.clientNum].time = level.time;
-			entity.oldEnt->credits[source->client->ps.clientNum].team = (team_t)source->client->pers.team;
+			G_AddDamageCredit(entity.oldEnt, source->client->ps.clientNum, loss,
+			                  (team_t)source->client->pers.team);
 		}
 	}
 
@@ -263,18 +262,25 @@ void HealthComponent::SetMaxHealth(float maxHealth, bool scaleHealth) {
 void HealthComponent::ScaleDamageAccounts(float healthRestored) {
 	if (healthRestored <= 0.0f) return;
 
+	damageLedger_t& ledger = entity.oldEnt->damageLedger;
+
 	// Get total damage account and remember relevant clients.
 	float totalAccreditedDamage = 0.0f;
-	std::vector<Entity*> relevantClients;
-	ForEntities<ClientComponent>([&](Entity& other, ClientComponent& client) {
-		float clientDamage = entity.oldEnt->credits[other.oldEnt->s.number].value;
-		if (clientDamage > 0.0f) {
-			totalAccreditedDamage += clientDamage;
-			relevantClients.push_back(&other);
+	damageCredit_t* relevantCredits[MAX_CLIENTS];
+	int numRelevantCredits = 0;
+	for (int i = 0; i < ledger.numCredits; i++) {
+		damageCredit_t& credit = ledger[i];
+
+		// Only count clients that are still around.
+		if (!g_entities[credit.clientNum].entity->Get<ClientComponent>()) continue;
+
+		if (credit.value > 0.0f) {
+			totalAccreditedDamage += credit.value;
+			relevantCredits[numRelevantCredits++] = &credit;
 		}
-	});
+	}
 
-	if (relevantClients.empty()) return;
+	if (!numRelevantCredits) return;
 
 	// Calculate account scale factor.
 	float scale;
@@ -282,16 +288,16 @@ void HealthComponent::ScaleDamageAccounts(float healthRestored) {
 		scale = (totalAccreditedDamage - healthRestored) / totalAccreditedDamage;
 
 		healthLogger.Debug("Scaling damage accounts of %i client(s) by %.2f.",
-		                   relevantClients.size(), scale);
+		                   numRelevantCredits, scale);
 	} else {
 		// Clear all accounts.
 		scale = 0.0f;
 
-		healthLogger.Debug("Clearing damage accounts of %i client(s).", relevantClients.size());
+		healthLogger.Debug("Clearing damage accounts of %i client(s).", numRelevantCredits);
 	}
 
 	// Scale down or clear damage accounts.
-	for (Entity* other : relevantClients) {
-		entity.oldEnt->credits[other->oldEnt->s.number].value *= scale;
+	for (int i = 0; i < numRelevantCredits; i++) {
+		relevantCredits[i]->value *= scale;
 	}
 }
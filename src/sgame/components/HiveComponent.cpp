@@ -52,9 +52,12 @@ void HiveComponent::Think(int timeDelta) {
 Entity* HiveComponent::FindTarget() {
 	Entity* target = nullptr;
 
-	ForEntities<HumanClassComponent>([&](Entity& candidate, HumanClassComponent& humanClassComponent) {
-		// Check if target is valid and in sense range.
-		if (!TargetValid(candidate, true)) return;
+	Vec3 origin = GetAlienBuildableComponent().GetBuildableComponent().GetLocationComponent().Origin();
+
+	ForEntitiesInRadius<HumanClassComponent>(origin, SENSE_RANGE,
+	                                         [&](Entity& candidate, HumanClassComponent& humanClassComponent) {
+		// Check if target is valid, the search is limited to the sense range already.
+		if (!TargetValid(candidate, false)) return;
 
 		// Check if better target.
 		if (!target || CompareTargets(candidate, *target)) {
@@ -38,8 +38,9 @@ const float IgnitableComponent::SPREAD_RADIUS           = 120.0f;
 static_assert(IgnitableComponent::BASE_AVERAGE_BURN_TIME > IgnitableComponent::MIN_BURN_TIME,
               "Average burn time needs to be greater than minimum burn time.");
 
-IgnitableComponent::IgnitableComponent(Entity& entity, bool alwaysOnFire, ThinkingComponent& r_ThinkingComponent)
-	: IgnitableComponentBase(entity, alwaysOnFire, r_ThinkingComponent)
+IgnitableComponent::IgnitableComponent(Entity& entity, bool alwaysOnFire, ThinkingComponent& r_ThinkingComponent,
+                                       LocationComponent& r_LocationComponent)
+	: IgnitableComponentBase(entity, alwaysOnFire, r_ThinkingComponent, r_LocationComponent)
 	, onFire(alwaysOnFire)
 	, igniteTime(alwaysOnFire ? level.time : 0)
 	, immuneUntil(0)
@@ -164,15 +165,14 @@ void IgnitableComponent::ConsiderStop(int timeDelta) {
 	float averagePostMinBurnTime = BASE_AVERAGE_BURN_TIME - MIN_BURN_TIME;
 
 	// Increase average burn time dynamically for burning entities in range.
-	ForEntities<IgnitableComponent>([&](Entity &other, IgnitableComponent &ignitable){
+	const LocationComponent& location = GetLocationComponent();
+
+	ForEntitiesInRadius<IgnitableComponent>(location.Origin(), EXTRA_BURN_TIME_RADIUS,
+	                                        [&](Entity &other, IgnitableComponent &ignitable){
 		if (&other == &entity) return;
 		if (!ignitable.onFire) return;
 
-		// TODO: Use LocationComponent.
-		float distance = G_Distance(other.oldEnt, entity.oldEnt);
-
-		if (distance > EXTRA_BURN_TIME_RADIUS) return;
-
+		float distance     = location.Distance(other);
 		float distanceFrac = distance / EXTRA_BURN_TIME_RADIUS;
 		float distanceMod  = 1.0f - distanceFrac;
 
@@ -204,17 +204,16 @@ void IgnitableComponent::ConsiderSpread(int timeDelta) {
 
 	fireLogger.Notice("Trying to spread.");
 
-	ForEntities<IgnitableComponent>([&](Entity &other, IgnitableComponent &ignitable){
+	const LocationComponent& location = GetLocationComponent();
+
+	ForEntitiesInRadius<IgnitableComponent>(location.Origin(), SPREAD_RADIUS,
+	                                        [&](Entity &other, IgnitableComponent &ignitable){
 		if (&other == &entity) return;
 
 		// Don't re-ignite.
 		if (ignitable.onFire) return;
 
-		// TODO: Use LocationComponent.
-		float distance = G_Distance(other.oldEnt, entity.oldEnt);
-
-		if (distance > SPREAD_RADIUS) return;
-
+		float distance     = location.Distance(other);
 		float distanceFrac = distance / SPREAD_RADIUS;
 		float distanceMod  = 1.0f - distanceFrac;
 		float spreadChance = distanceMod;
@@ -60,9 +60,10 @@ class IgnitableComponent: public IgnitableComponentBase {
 		 * @param entity The entity that owns the component instance.
 		 * @param alwaysOnFire An initialization parameter.
 		 * @param r_ThinkingComponent A ThinkingComponent instance that this component depends on.
+		 * @param r_LocationComponent A LocationComponent instance that this component depends on.
 		 * @note This method is an interface for autogenerated code, do not modify its signature.
 		 */
-		IgnitableComponent(Entity& entity, bool alwaysOnFire, ThinkingComponent& r_ThinkingComponent);
+		IgnitableComponent(Entity& entity, bool alwaysOnFire, ThinkingComponent& r_ThinkingComponent, LocationComponent& r_LocationComponent);
 
 		/**
 		 * @brief Handle the PrepareNetCode message.
@@ -0,0 +1,9 @@
+#include "LocationComponent.h"
+
+LocationComponent::LocationComponent(Entity& entity)
+	: LocationComponentBase(entity)
+{}
+
+float LocationComponent::Distance(const Entity& other) const {
+	return Math::Distance(Origin(), Vec3::Load(other.oldEnt->s.origin));
+}
@@ -0,0 +1,75 @@
+#ifndef LOCATION_COMPONENT_H_
+#define LOCATION_COMPONENT_H_
+
+#include "../backend/CBSEBackend.h"
+#include "../backend/CBSEComponents.h"
+
+#include <initializer_list>
+
+class LocationComponent: public LocationComponentBase {
+	public:
+		// ///////////////////// //
+		// Autogenerated Members //
+		// ///////////////////// //
+
+		/**
+		 * @brief Default constructor of the LocationComponent.
+		 * @param entity The entity that owns the component instance.
+		 * @note This method is an interface for autogenerated code, do not modify its signature.
+		 */
+		LocationComponent(Entity& entity);
+
+		// ///////////////////// //
+
+		Vec3 Origin() const {
+			return Vec3::Load(entity.oldEnt->s.origin);
+		}
+
+		/**
+		 * @return The distance between the origins of this and another entity.
+		 */
+		float Distance(const Entity& other) const;
+
+	private:
+
+};
+
+/**
+ * @brief Calls a function for every entity that has all of the given components and its origin
+ *        within a radius, like ForEntities does for all such entities.
+ *
+ * Entities are looked up in the world broadphase, which keeps them sorted into a grid whenever
+ * they are linked, so the cost depends on the number of entities near the origin rather than on
+ * the total. Unlinked entities, like spectators, are never found.
+ */
+template<typename... Components, typename FuncType>
+void ForEntitiesInRadius(Vec3 origin, float radius, FuncType f) {
+	gentity_t *entities[MAX_GENTITIES];
+	vec3_t mins, maxs;
+
+	for (int i = 0; i < 3; i++) {
+		mins[i] = origin[i] - radius;
+		maxs[i] = origin[i] + radius;
+	}
+
+	int numEntities = G_EntitiesInBox(mins, maxs, entities, MAX_GENTITIES);
+
+	for (int i = 0; i < numEntities; i++) {
+		gentity_t *ent = entities[i];
+
+		// An earlier call may have freed the entity.
+		if (!ent->inuse || !ent->entity) continue;
+
+		Entity& other = *ent->entity;
+		bool hasComponents = true;
+
+		(void)std::initializer_list<int>{(hasComponents = hasComponents && other.Get<Components>(), 0)...};
+
+		if (!hasComponents) continue;
+		if (Math::DistanceSq(origin, Vec3::Load(ent->s.origin)) > radius * radius) continue;
+
+		f(other, *other.Get<Components>()...);
+	}
+}
+
+#endif // LOCATION_COMPONENT_H_
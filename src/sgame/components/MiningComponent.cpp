@@ -1,8 +1,9 @@
 #include "MiningComponent.h"
 
 MiningComponent::MiningComponent(Entity& entity, bool blueprint,
-                                 ThinkingComponent& r_ThinkingComponent)
-	: MiningComponentBase(entity, blueprint, r_ThinkingComponent)
+                                 ThinkingComponent& r_ThinkingComponent,
+                                 LocationComponent& r_LocationComponent)
+	: MiningComponentBase(entity, blueprint, r_ThinkingComponent, r_LocationComponent)
 	, active(false) {
 
 	// Already calculate the predicted efficiency.
@@ -66,7 +67,13 @@ void MiningComponent::CalculateEfficiency() {
 	currentEfficiency   = active ? 1.0f : 0.0f;
 	predictedEfficiency = 1.0f;
 
-	ForEntities<MiningComponent>([&] (Entity& other, MiningComponent& miningComponent) {
+	// Miners don't interfere without a range, or further apart than twice of it.
+	if (RGS_RANGE <= 0.0f) return;
+
+	const LocationComponent& location = GetLocationComponent();
+
+	ForEntitiesInRadius<MiningComponent>(location.Origin(), 2.0f * RGS_RANGE,
+	                                     [&] (Entity& other, MiningComponent& miningComponent) {
 		if (&other == &entity) return;
 
 		// Never consider blueprint miners.
@@ -76,7 +83,7 @@ void MiningComponent::CalculateEfficiency() {
 		HealthComponent *healthComponent = other.Get<HealthComponent>();
 		if (healthComponent && !healthComponent->Alive()) return;
 
-		float interferenceMod = InterferenceMod(G_Distance(entity.oldEnt, other.oldEnt));
+		float interferenceMod = InterferenceMod(location.Distance(other));
 
 		// TODO: Exclude enemy miners in construction from the prediction.
 
@@ -97,9 +104,9 @@ void MiningComponent::InformNeighbors() {
 	// about them.
 	if (blueprint) return;
 
-	ForEntities<MiningComponent>([&] (Entity& other, MiningComponent& miningComponent) {
+	ForEntitiesInRadius<MiningComponent>(GetLocationComponent().Origin(), RGS_RANGE * 2.0f,
+	                                     [&] (Entity& other, MiningComponent& miningComponent) {
 		if (&other == &entity) return;
-		if (G_Distance(entity.oldEnt, other.oldEnt) > RGS_RANGE * 2.0f) return;
 
 		miningComponent.CalculateEfficiency();
 	});
@@ -15,9 +15,10 @@ class MiningComponent: public MiningComponentBase {
 		 * @param entity The entity that owns the component instance.
 		 * @param blueprint An initialization parameter.
 		 * @param r_ThinkingComponent A ThinkingComponent instance that this component depends on.
+		 * @param r_LocationComponent A LocationComponent instance that this component depends on.
 		 * @note This method is an interface for autogenerated code, do not modify its signature.
 		 */
-		MiningComponent(Entity& entity, bool blueprint, ThinkingComponent& r_ThinkingComponent);
+		MiningComponent(Entity& entity, bool blueprint, ThinkingComponent& r_ThinkingComponent, LocationComponent& r_LocationComponent);
 
 		/**
 		 * @brief Handle the PrepareNetCode message.
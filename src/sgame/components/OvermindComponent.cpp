@@ -33,9 +33,8 @@ void OvermindComponent::Think(int timeDelta) {
 	storedTarget = target ? target->oldEnt : nullptr;
 
 	// If target is an enemy in reach, attack it.
-	// TODO: Add LocationComponent and Utility::Distance.
 	if (target && Entities::OnOpposingTeams(entity, *target) &&
-	    G_Distance(entity.oldEnt, target->oldEnt) < ATTACK_RANGE) {
+	    GetAlienBuildableComponent().GetBuildableComponent().GetLocationComponent().Distance(*target) < ATTACK_RANGE) {
 
 		float damage = ATTACK_DAMAGE * ((float)timeDelta / 1000.0f);
 
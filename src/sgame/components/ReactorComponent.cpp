@@ -17,13 +17,17 @@ void ReactorComponent::Think(int timeDelta) {
 
 	float baseDamage = ATTACK_DAMAGE * ((float)timeDelta / 1000.0f);
 
+	const LocationComponent& location =
+		GetMainBuildableComponent().GetBuildableComponent().GetLocationComponent();
+
 	// Zap close enemies.
-	ForEntities<AlienClassComponent>([&](Entity& other, AlienClassComponent&) {
+	ForEntitiesInRadius<AlienClassComponent>(location.Origin(), ATTACK_RANGE,
+	                                         [&](Entity& other, AlienClassComponent&) {
 		// Respect the no-target flag.
 		if (other.oldEnt->flags & FL_NOTARGET) return;
 
-		// TODO: Add LocationComponent and Utility::BBOXDistance.
-		float distance = G_Distance(entity.oldEnt, other.oldEnt);
+		// TODO: Add Utility::BBOXDistance.
+		float distance = location.Distance(other);
 
 		if (distance >= ATTACK_RANGE) return;
 
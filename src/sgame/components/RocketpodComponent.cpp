@@ -1,5 +1,6 @@
 #include "RocketpodComponent.h"
 #include "../Entities.h"
+#include "../sg_targets.h"
 
 constexpr float ATTACK_RANGE         = (float)ROCKETPOD_RANGE; // cgame needs to know this.
 constexpr int   ATTACK_PERIOD        = ROCKETPOD_ATTACK_PERIOD; // cgame needs to know this.
@@ -237,26 +238,30 @@ bool RocketpodComponent::EnemyClose() {
 
 	bool enemyClose = false;
 
-	ForEntities<ClientComponent>([&](Entity& other, ClientComponent& clientComponent) {
+	Vec3 turretMins, turretMaxs;
+	BG_BuildableBoundingBox(BA_H_ROCKETPOD, turretMins.Data(), turretMaxs.Data());
+
+	float turretRadius  = std::max(Math::Length(turretMins), Math::Length(turretMaxs));
+	float missileRadius = missileAttributes->size;
+	float splashRadius  = missileAttributes->splashRadius;
+
+	// This protects the rocketpod from its own splash damage, so enemies it won't target count too.
+	G_ForTargetsInRange(G_Enemy(G_Team(entity.oldEnt)), TARGET_PLAYERS | TARGET_NOTARGET,
+	                    Vec3::Load(entity.oldEnt->s.origin), FLT_MAX,
+	                    [&](const targetCandidate_t& candidate) {
 		if (enemyClose) return;
 
-		if (other.Get<SpectatorComponent>()) return;
+		Entity& other = *candidate.ent.entity->entity;
+
 		if (Entities::IsDead(other)) return;
-		if (!Entities::OnOpposingTeams(entity, other)) return;
 
 		float distance = G_Distance(entity.oldEnt, other.oldEnt);
 
 		classModelConfig_t* cmc = BG_ClassModelConfig(other.oldEnt->client->pers.classSelection);
 
-		Vec3 turretMins, turretMaxs;
-		BG_BuildableBoundingBox(BA_H_ROCKETPOD, turretMins.Data(), turretMaxs.Data());
-
 		float enemyRadius   = std::max(
 			Math::Length(Vec3::Load(cmc->mins)), Math::Length(Vec3::Load(cmc->maxs))
 		);
-		float turretRadius  = std::max(Math::Length(turretMins), Math::Length(turretMaxs));
-		float missileRadius = missileAttributes->size;
-		float splashRadius  = missileAttributes->splashRadius;
 
 		// The center of explosion cannot be closer to own origin than this.
 		float closestExplosionCenter = distance - (enemyRadius + missileRadius);
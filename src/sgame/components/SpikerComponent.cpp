@@ -1,4 +1,6 @@
 #include "SpikerComponent.h"
+#include "../Entities.h"
+#include "../sg_targets.h"
 
 static Log::Logger logger("sgame.spiker");
 
@@ -65,30 +67,33 @@ void SpikerComponent::Think(int timeDelta) {
 	float expectedDamage = 0.0f;
 	bool  sensing = false;
 
+	Vec3 origin = GetAlienBuildableComponent().GetBuildableComponent().GetLocationComponent().Origin();
+
+	Vec3 dorsal = Vec3::Load(entity.oldEnt->s.origin2);
+
 	// Calculate expected damage to decide on the best moment to shoot.
-	ForEntities<HealthComponent>([&](Entity& other, HealthComponent& healthComponent) {
-		if (G_Team(other.oldEnt) == TEAM_NONE)                            return;
-		if (G_OnSameTeam(entity.oldEnt, other.oldEnt))                    return;
-		if ((other.oldEnt->flags & FL_NOTARGET))                          return;
-		if (!healthComponent.Alive())                                     return;
-		if (G_Distance(entity.oldEnt, other.oldEnt) > SPIKE_RANGE)        return;
-		if (other.Get<BuildableComponent>())                              return;
-		if (!G_LineOfSight(entity.oldEnt, other.oldEnt))                  return;
-
-		Vec3 dorsal    = Vec3::Load(entity.oldEnt->s.origin2);
-		Vec3 toTarget  = Vec3::Load(other.oldEnt->s.origin) - Vec3::Load(entity.oldEnt->s.origin);
-		Vec3 otherMins = Vec3::Load(other.oldEnt->r.mins);
-		Vec3 otherMaxs = Vec3::Load(other.oldEnt->r.maxs);
-
-		// With a straight shot, only entities in the spiker's upper hemisphere can be hit.
-		// Since the spikes obey gravity, increase or decrease this radius of damage by up to
-		// GRAVITY_COMPENSATION_ANGLE degrees depending on the spiker's orientation.
+	// With a straight shot, only entities in the spiker's upper hemisphere can be hit.
+	// Since the spikes obey gravity, increase or decrease this radius of damage by up to
+	// GRAVITY_COMPENSATION_ANGLE degrees depending on the spiker's orientation.
+	G_ForTargetsInCone(G_Enemy(G_Team(entity.oldEnt)), TARGET_PLAYERS, origin, SPIKE_RANGE, dorsal,
+	                   gravityCompensation, [&](const targetCandidate_t& candidate) {
+		gentity_t* other = candidate.ent.entity;
+
+		Vec3 toTarget  = Vec3::Load(other->s.origin) - origin;
+		Vec3 otherMins = Vec3::Load(other->r.mins);
+		Vec3 otherMaxs = Vec3::Load(other->r.maxs);
+		float distance = Math::Length(toTarget);
+
+		// The index is only accurate to the movement since it was built.
+		if (distance > SPIKE_RANGE)                                           return;
 		if (Math::Dot(Math::Normalize(toTarget), dorsal) < gravityCompensation) return;
+		if ((other->flags & FL_NOTARGET))                                     return;
+		if (!Entities::IsAlive(other))                                        return;
+		if (!G_LineOfSight(entity.oldEnt, other))                             return;
 
 		// Approximate average damage the entity would receive from spikes.
 		const missileAttributes_t* ma = BG_Missile(MIS_SPIKER);
 		float spikeDamage  = ma->damage;
-		float distance     = Math::Length(toTarget);
 		float bboxDiameter = Math::Length(otherMins) + Math::Length(otherMaxs);
 		float bboxEdge     = (1.0f / M_ROOT3) * bboxDiameter; // Assumes a cube.
 		float hitEdge      = bboxEdge + ((1.0f / M_ROOT3) * ma->size); // Add half missile edge.
@@ -1,15 +1,48 @@
 #include "ThinkingComponent.h"
 
+#include <queue>
+
 static Log::Logger thinkLogger("sgame.thinking");
 
+float ThinkingComponent::averageFrameTime = 0.0f;
+
+/**
+ * @brief An entry of the queue of components waiting for their next thinker to become due.
+ *
+ * Entries aren't removed when a component is rescheduled or destroyed, instead outdated ones are
+ * recognized and dropped when they come up.
+ */
+struct thinkWakeUp_t {
+	int time;
+	int entityNum;
+	unsigned generation;
+
+	bool operator>(const thinkWakeUp_t &other) const {
+		return time > other.time;
+	}
+};
+
+static std::priority_queue<thinkWakeUp_t, std::vector<thinkWakeUp_t>, std::greater<thinkWakeUp_t>> wakeUpQueue;
+
 ThinkingComponent::ThinkingComponent(Entity& entity, DeferredFreeingComponent& r_DeferredFreeingComponent)
 	: ThinkingComponentBase(entity, r_DeferredFreeingComponent)
 	, iteratingThinkers(false)
 	, unregisterActiveThinker(false)
-	, averageFrameTime(0)
 	, lastThinkRound(-1)
+	, nextThinkTime(INT_MAX)
+	, queuedTime(INT_MAX)
 {}
 
+void ThinkingComponent::BeginFrame() {
+	int frameTime = level.time - level.previousTime;
+
+	if (!averageFrameTime) {
+		averageFrameTime = frameTime;
+	} else {
+		averageFrameTime = averageFrameTime * (1.0f - averageChangeRate) + frameTime * averageChangeRate;
+	}
+}
+
 void ThinkingComponent::Think() {
 	int time = level.time;
 
@@ -18,16 +51,13 @@ void ThinkingComponent::Think() {
 		return;
 	}
 
-	lastThinkRound = time;
-
-	int frameTime = level.time - level.previousTime;
-
-	if (!averageFrameTime) {
-		averageFrameTime = frameTime;
-	} else {
-		averageFrameTime = averageFrameTime * (1.0f - averageChangeRate) + frameTime * averageChangeRate;
+	// None of the thinkers can be due yet.
+	if (time < nextThinkTime) {
+		return;
 	}
 
+	lastThinkRound = time;
+
 	iteratingThinkers = true;
 	for (thinkRecord_t &record : thinkers) {
 		int timeDelta = time - record.timestamp;
@@ -75,6 +105,8 @@ void ThinkingComponent::Think() {
 	// Add thinkers that were registered during iteration.
 	thinkers.insert(thinkers.end(), newThinkers.begin(), newThinkers.end());
 	newThinkers.clear();
+
+	Schedule();
 }
 
 int ThinkingComponent::GetLastThinkTime() const {
@@ -88,6 +120,11 @@ void ThinkingComponent::RegisterThinker(thinker_t thinker, thinkScheduler_t sche
 
 	addTo->emplace_back(thinkRecord_t{thinker, scheduler, period, level.time, 0, false});
 
+	// Thinkers added during iteration are scheduled once it ends.
+	if (!iteratingThinkers) {
+		Schedule();
+	}
+
 	thinkLogger.Notice("Registered thinker of period %i.", period);
 }
 
@@ -96,3 +133,93 @@ void ThinkingComponent::UnregisterActiveThinker() {
 
 	thinkLogger.Notice("Unregistered the active thinker.");
 }
+
+int ThinkingComponent::EarliestThinkTime(const thinkRecord_t &record) const {
+	// The conditions of Think solved for the time, see there. A thinker that would run
+	// one frame early runs when its lateness this frame is higher than the one predicted
+	// for the next frame, that is as soon as it is less than half a frame early.
+	float earliest = record.timestamp + record.period;
+
+	switch (record.scheduler) {
+		case SCHEDULER_AFTER:
+			break;
+
+		case SCHEDULER_BEFORE:
+			earliest -= averageFrameTime;
+			break;
+
+		case SCHEDULER_CLOSEST:
+			earliest -= 0.5f * averageFrameTime;
+			break;
+
+		case SCHEDULER_AVERAGE:
+			earliest -= record.delay + 0.5f * averageFrameTime;
+			break;
+	}
+
+	// The frame time prediction may grow until then, so rather wake up a frame too early.
+	return (int)floorf(earliest - averageFrameTime);
+}
+
+void ThinkingComponent::Schedule() {
+	nextThinkTime = INT_MAX;
+
+	for (const thinkRecord_t &record : thinkers) {
+		nextThinkTime = std::min(nextThinkTime, EarliestThinkTime(record));
+	}
+
+	// This component already thought this frame, so it can't be woken up before the next one.
+	int wakeUpTime = std::max(nextThinkTime, level.time + 1);
+
+	if (nextThinkTime == INT_MAX || wakeUpTime == queuedTime) {
+		return;
+	}
+
+	// Temporary entities that aren't part of g_entities, like the ones used for predictions,
+	// never think.
+	int entityNum = entity.oldEnt - g_entities;
+
+	if (entityNum < 0 || entityNum >= MAX_GENTITIES) {
+		return;
+	}
+
+	queuedTime = wakeUpTime;
+	wakeUpQueue.push({wakeUpTime, entityNum, entity.oldEnt->generation});
+}
+
+void ThinkingComponent::RunMissed() {
+	while (!wakeUpQueue.empty() && wakeUpQueue.top().time <= level.time) {
+		thinkWakeUp_t wakeUp = wakeUpQueue.top();
+		wakeUpQueue.pop();
+
+		gentity_t *ent = &g_entities[wakeUp.entityNum];
+
+		if (!ent->inuse || ent->generation != wakeUp.generation) continue;
+
+		ThinkingComponent *thinkingComponent = ent->entity->Get<ThinkingComponent>();
+
+		// The component was rescheduled since.
+		if (!thinkingComponent || thinkingComponent->queuedTime != wakeUp.time) continue;
+
+		thinkingComponent->queuedTime = INT_MAX;
+
+		// A newly created entity can randomly run things, or not, in the G_RunFrames loop over
+		// entities depending on whether it was added in a hole in g_entities or at the end, so
+		// ignore the entity if it was created this frame.
+		if (ent->creationTime != level.time && thinkingComponent->lastThinkRound != level.time &&
+		    level.time >= thinkingComponent->nextThinkTime) {
+			Log::Warn("ThinkingComponent was not called");
+			thinkingComponent->Think();
+		}
+
+		// Think reschedules it only if it actually ran.
+		if (thinkingComponent->queuedTime == INT_MAX) {
+			thinkingComponent->Schedule();
+		}
+	}
+}
+
+void ThinkingComponent::ResetSchedule() {
+	wakeUpQueue = {};
+	averageFrameTime = 0.0f;
+}
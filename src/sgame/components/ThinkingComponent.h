@@ -35,12 +35,32 @@ class ThinkingComponent: public ThinkingComponentBase {
 
 		// ///////////////////// //
 
+		/**
+		 * @brief Runs the thinkers that are due. Returns immediately while none can be.
+		 */
 		void Think();
 
 		int GetLastThinkTime() const;
 		void RegisterThinker(thinker_t thinker, thinkScheduler_t scheduler, int period);
 		void UnregisterActiveThinker();
 
+		/**
+		 * @brief Updates the frame time prediction shared by all thinkers. Call once per frame
+		 *        before any entity thinks.
+		 */
+		static void BeginFrame();
+
+		/**
+		 * @brief Runs the components that are due but weren't called in the frame, using the
+		 *        global wake up queue rather than visiting all thinking entities.
+		 */
+		static void RunMissed();
+
+		/**
+		 * @brief Forgets all scheduled wake ups, for a new game.
+		 */
+		static void ResetSchedule();
+
 	private:
 		struct thinkRecord_t {
 			thinker_t thinker;
@@ -58,11 +78,20 @@ class ThinkingComponent: public ThinkingComponentBase {
 
 		bool unregisterActiveThinker;
 
-		float averageFrameTime; /**< Smoothed out average frame time for predictions. */
+		/** Returns the earliest time at which the thinker might run. */
+		int EarliestThinkTime(const thinkRecord_t &record) const;
+
+		/** Computes nextThinkTime and queues the component to wake up then. */
+		void Schedule();
+
+		static float averageFrameTime; /**< Smoothed out average frame time for predictions. */
 
 		constexpr static float averageChangeRate = 0.1f;
 
 		int lastThinkRound; /**< Used to make sure that we think at most once per frame. */
+
+		int nextThinkTime; /**< No thinker can be due before this time. */
+		int queuedTime; /**< Time of the entry of this component in the wake up queue. */
 };
 
 #endif // THINKING_COMPONENT_H_
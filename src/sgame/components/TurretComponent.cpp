@@ -1,5 +1,6 @@
 #include "TurretComponent.h"
 #include "../Entities.h"
+#include "../sg_targets.h"
 
 static Log::Logger turretLogger("sgame.turrets");
 
@@ -58,12 +59,17 @@ Entity* TurretComponent::FindEntityTarget(std::function<bool(Entity&, Entity&)>
 	// Delete old target.
 	RemoveTarget();
 
-	// Search best target.
-	// TODO: Iterate over all valid targets, do not assume they have to be clients.
-	ForEntities<ClientComponent>([&](Entity& candidate, ClientComponent& clientComponent) {
-		if (TargetValid(candidate, true)) {
-			if (!target || CompareTargets(candidate, *target->entity)) {
-				target = candidate.oldEnt;
+	// Search best target among the enemies in range, from the index shared by all turrets.
+	// TODO: Also consider buildables, which the index provides but TargetValid rejects.
+	Vec3 origin = Vec3::Load(entity.oldEnt->s.origin);
+
+	G_ForTargetsInRange(G_Enemy(G_Team(entity.oldEnt)), TARGET_PLAYERS, origin, range,
+	                    [&](const targetCandidate_t& candidate) {
+		Entity& candidateEntity = *candidate.ent.entity->entity;
+
+		if (TargetValid(candidateEntity, true)) {
+			if (!target || CompareTargets(candidateEntity, *target->entity)) {
+				target = candidate.ent.entity;
 			}
 		}
 	});
@@ -55,6 +55,7 @@ class TurretComponent: public TurretComponentBase {
 		 *        should be chosen by a fair coin flip if both targets are to be considered equally
 		 *        good.
 		 * @return The target chosen or nullptr.
+		 * @note Candidates come from the per-frame target index, see sg_targets.h.
 		 * @todo Allow TargetValid to be given as a parameter so specific turrets can use a
 		 *       different validity check. Also fix the function to not only consider clients.
 		 */
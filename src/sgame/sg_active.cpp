@@ -27,6 +27,8 @@ Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
 #include "sg_local.h"
 #include "Entities.h"
 #include "CBSE.h"
+#include "sg_profiler.h"
+#include "sg_pmovereplay.h"
 
 bool ClientInactivityTimer( gentity_t *ent, bool active );
 
@@ -889,6 +891,7 @@ void ClientTimerActions( gentity_t *ent, int msec )
 
 	if( ent->r.svFlags & SVF_BOT )
 	{
+		G_ProfileScope profile( PROFILE_BOT_THINK );
 		G_BotThink( ent );
 	}
 
@@ -1254,16 +1257,16 @@ void SendPendingPredictableEvents( playerState_t *ps )
 ==============
  G_UnlaggedStore
 
- Called on every server frame.  Stores position data for the client at that
- into client->unlaggedHist[] and the time into level.unlaggedTimes[].
+ Called on every server frame.  Stores position data for all clients into
+ level.unlaggedFrames[] and the time into level.unlaggedTimes[].
  This data is used by G_UnlaggedCalc()
 ==============
 */
 void G_UnlaggedStore()
 {
-	int        i = 0;
-	gentity_t  *ent;
-	unlagged_t *save;
+	int             i = 0;
+	gentity_t       *ent;
+	unlaggedFrame_t *save;
 
 	if ( !g_unlagged.integer )
 	{
@@ -1277,13 +1280,18 @@ void G_UnlaggedStore()
 		level.unlaggedIndex = 0;
 	}
 
+	if ( level.unlaggedCount < MAX_UNLAGGED_MARKERS )
+	{
+		level.unlaggedCount++;
+	}
+
 	level.unlaggedTimes[ level.unlaggedIndex ] = level.time;
+	save = &level.unlaggedFrames[ level.unlaggedIndex ];
 
 	for ( i = 0; i < level.maxclients; i++ )
 	{
 		ent = &g_entities[ i ];
-		save = &ent->client->unlaggedHist[ level.unlaggedIndex ];
-		save->used = false;
+		save->used[ i ] = false;
 
 		if ( !ent->r.linked || !( ent->r.contents & CONTENTS_BODY ) )
 		{
@@ -1295,10 +1303,10 @@ void G_UnlaggedStore()
 			continue;
 		}
 
-		VectorCopy( ent->r.mins, save->mins );
-		VectorCopy( ent->r.maxs, save->maxs );
-		VectorCopy( ent->s.pos.trBase, save->origin );
-		save->used = true;
+		VectorCopy( ent->r.mins, save->mins[ i ] );
+		VectorCopy( ent->r.maxs, save->maxs[ i ] );
+		VectorCopy( ent->s.pos.trBase, save->origin[ i ] );
+		save->used[ i ] = true;
 	}
 }
 
@@ -1306,36 +1314,51 @@ void G_UnlaggedStore()
 ==============
  G_UnlaggedClear
 
- Mark all unlaggedHist[] markers for this client invalid.  Useful for
+ Mark all history markers for this client invalid.  Useful for
  preventing teleporting and death.
 ==============
 */
 void G_UnlaggedClear( gentity_t *ent )
 {
 	int i;
+	int clientNum = ent->client - level.clients;
 
 	for ( i = 0; i < MAX_UNLAGGED_MARKERS; i++ )
 	{
-		ent->client->unlaggedHist[ i ].used = false;
+		level.unlaggedFrames[ i ].used[ clientNum ] = false;
 	}
 }
 
+/*
+==============
+ G_UnlaggedMarker
+
+ Returns the index in level.unlaggedFrames[] of the nth oldest marker
+==============
+*/
+static int G_UnlaggedMarker( int n )
+{
+	int index = level.unlaggedIndex - level.unlaggedCount + 1 + n;
+
+	return ( index + MAX_UNLAGGED_MARKERS ) % MAX_UNLAGGED_MARKERS;
+}
+
 /*
 ==============
  G_UnlaggedCalc
 
- Loops through all active clients and calculates their predicted position
- for time then stores it in client->unlaggedCalc
+ Calculates the predicted position of all active clients for time then
+ stores it in client->unlaggedCalc
 ==============
 */
 void G_UnlaggedCalc( int time, gentity_t *rewindEnt )
 {
-	int       i = 0;
-	gentity_t *ent;
-	int       startIndex = level.unlaggedIndex;
-	int       stopIndex = -1;
-	int       frameMsec = 0;
-	float     lerp = 0.5f;
+	int             i = 0;
+	gentity_t       *ent;
+	int             startIndex, stopIndex;
+	int             frameMsec = 0;
+	float           lerp = 0.0f;
+	unlaggedFrame_t *start, *stop;
 
 	if ( !g_unlagged.integer )
 	{
@@ -1343,56 +1366,66 @@ void G_UnlaggedCalc( int time, gentity_t *rewindEnt )
 	}
 
 	// clear any calculated values from a previous run
-	for ( i = 0; i < level.maxclients; i++ )
+	for ( i = 0; i < level.numUnlaggedCalcClients; i++ )
 	{
-		ent = &g_entities[ i ];
+		level.clients[ level.unlaggedCalcClients[ i ] ].unlaggedCalc.used = false;
+	}
 
-		if ( !ent->inuse )
-		{
-			continue;
-		}
+	level.numUnlaggedCalcClients = 0;
 
-		ent->client->unlaggedCalc.used = false;
-	}
+	// find the newest marker that isn't after time, the markers are
+	// stored in chronological order
+	int low = 0, high = level.unlaggedCount;
 
-	for ( i = 0; i < MAX_UNLAGGED_MARKERS; i++ )
+	while ( low < high )
 	{
-		if ( level.unlaggedTimes[ startIndex ] <= time )
+		int middle = ( low + high ) / 2;
+
+		if ( level.unlaggedTimes[ G_UnlaggedMarker( middle ) ] <= time )
 		{
-			break;
+			low = middle + 1;
 		}
-
-		stopIndex = startIndex;
-
-		if ( --startIndex < 0 )
+		else
 		{
-			startIndex = MAX_UNLAGGED_MARKERS - 1;
+			high = middle;
 		}
 	}
 
-	if ( i == MAX_UNLAGGED_MARKERS )
+	// client is on the current frame, no need for unlagged
+	if ( low == level.unlaggedCount )
 	{
-		// if we searched all markers and the oldest one still isn't old enough
-		// just use the oldest marker with no lerping
-		lerp = 0.0f;
+		return;
 	}
 
-	// client is on the current frame, no need for unlagged
-	if ( stopIndex == -1 )
+	if ( low == 0 )
 	{
-		return;
+		// even the oldest marker isn't old enough,
+		// just use it with no lerping
+		startIndex = stopIndex = G_UnlaggedMarker( 0 );
 	}
+	else
+	{
+		// lerp between two markers
+		startIndex = G_UnlaggedMarker( low - 1 );
+		stopIndex = G_UnlaggedMarker( low );
 
-	// lerp between two markers
-	frameMsec = level.unlaggedTimes[ stopIndex ] -
-	            level.unlaggedTimes[ startIndex ];
+		frameMsec = level.unlaggedTimes[ stopIndex ] -
+		            level.unlaggedTimes[ startIndex ];
 
-	if ( frameMsec > 0 )
-	{
-		lerp = ( float )( time - level.unlaggedTimes[ startIndex ] ) /
-		       ( float ) frameMsec;
+		if ( frameMsec > 0 )
+		{
+			lerp = ( float )( time - level.unlaggedTimes[ startIndex ] ) /
+			       ( float ) frameMsec;
+		}
+		else
+		{
+			lerp = 0.5f;
+		}
 	}
 
+	start = &level.unlaggedFrames[ startIndex ];
+	stop = &level.unlaggedFrames[ stopIndex ];
+
 	for ( i = 0; i < level.maxclients; i++ )
 	{
 		ent = &g_entities[ i ];
@@ -1402,43 +1435,45 @@ void G_UnlaggedCalc( int time, gentity_t *rewindEnt )
 			continue;
 		}
 
-		if ( !ent->inuse )
+		if ( !start->used[ i ] || !stop->used[ i ] )
 		{
 			continue;
 		}
 
-		if ( !ent->r.linked || !( ent->r.contents & CONTENTS_BODY ) )
+		if ( !ent->inuse )
 		{
 			continue;
 		}
 
-		if ( ent->client->pers.connected != CON_CONNECTED )
+		if ( !ent->r.linked || !( ent->r.contents & CONTENTS_BODY ) )
 		{
 			continue;
 		}
 
-		if ( !ent->client->unlaggedHist[ startIndex ].used )
+		if ( ent->client->pers.connected != CON_CONNECTED )
 		{
 			continue;
 		}
 
-		if ( !ent->client->unlaggedHist[ stopIndex ].used )
+		unlagged_t *calc = &ent->client->unlaggedCalc;
+
+		// between two unlagged markers
+		VectorLerpTrem( lerp, start->mins[ i ], stop->mins[ i ], calc->mins );
+		VectorLerpTrem( lerp, start->maxs[ i ], stop->maxs[ i ], calc->maxs );
+		VectorLerpTrem( lerp, start->origin[ i ], stop->origin[ i ], calc->origin );
+
+		// the box is relative to the origin
+		calc->radius = 0.0f;
+
+		for ( int j = 0; j < 3; j++ )
 		{
-			continue;
+			calc->radius += Square( std::max( fabsf( calc->mins[ j ] ), fabsf( calc->maxs[ j ] ) ) );
 		}
 
-		// between two unlagged markers
-		VectorLerpTrem( lerp, ent->client->unlaggedHist[ startIndex ].mins,
-		                ent->client->unlaggedHist[ stopIndex ].mins,
-		                ent->client->unlaggedCalc.mins );
-		VectorLerpTrem( lerp, ent->client->unlaggedHist[ startIndex ].maxs,
-		                ent->client->unlaggedHist[ stopIndex ].maxs,
-		                ent->client->unlaggedCalc.maxs );
-		VectorLerpTrem( lerp, ent->client->unlaggedHist[ startIndex ].origin,
-		                ent->client->unlaggedHist[ stopIndex ].origin,
-		                ent->client->unlaggedCalc.origin );
-
-		ent->client->unlaggedCalc.used = true;
+		calc->radius = sqrtf( calc->radius );
+		calc->used = true;
+
+		level.unlaggedCalcClients[ level.numUnlaggedCalcClients++ ] = i;
 	}
 }
 
@@ -1459,9 +1494,9 @@ void G_UnlaggedOff()
 		return;
 	}
 
-	for ( i = 0; i < level.maxclients; i++ )
+	for ( i = 0; i < level.numUnlaggedMovedClients; i++ )
 	{
-		ent = &g_entities[ i ];
+		ent = &g_entities[ level.unlaggedMovedClients[ i ] ];
 
 		if ( !ent->client->unlaggedBackup.used )
 		{
@@ -1474,6 +1509,8 @@ void G_UnlaggedOff()
 		ent->client->unlaggedBackup.used = false;
 		trap_LinkEntity( ent );
 	}
+
+	level.numUnlaggedMovedClients = 0;
 }
 
 /*
@@ -1506,9 +1543,10 @@ void G_UnlaggedOn( gentity_t *attacker, vec3_t muzzle, float range )
 		return;
 	}
 
-	for ( i = 0; i < level.maxclients; i++ )
+	// only the clients G_UnlaggedCalc() found a position for can be moved
+	for ( i = 0; i < level.numUnlaggedCalcClients; i++ )
 	{
-		ent = &g_entities[ i ];
+		ent = &g_entities[ level.unlaggedCalcClients[ i ] ];
 		calc = &ent->client->unlaggedCalc;
 
 		if ( !calc->used )
@@ -1521,26 +1559,19 @@ void G_UnlaggedOn( gentity_t *attacker, vec3_t muzzle, float range )
 			continue;
 		}
 
-		if ( !ent->r.linked || !( ent->r.contents & CONTENTS_BODY ) )
+		if ( muzzle && DistanceSquared( muzzle, calc->origin ) > Square( range + calc->radius ) )
 		{
 			continue;
 		}
 
-		if ( VectorCompare( ent->r.currentOrigin, calc->origin ) )
+		if ( !ent->r.linked || !( ent->r.contents & CONTENTS_BODY ) )
 		{
 			continue;
 		}
 
-		if ( muzzle )
+		if ( VectorCompare( ent->r.currentOrigin, calc->origin ) )
 		{
-			float r1 = Distance( calc->origin, calc->maxs );
-			float r2 = Distance( calc->origin, calc->mins );
-			float maxRadius = ( r1 > r2 ) ? r1 : r2;
-
-			if ( Distance( muzzle, calc->origin ) > range + maxRadius )
-			{
-				continue;
-			}
+			continue;
 		}
 
 		// create a backup of the real positions
@@ -1548,6 +1579,7 @@ void G_UnlaggedOn( gentity_t *attacker, vec3_t muzzle, float range )
 		VectorCopy( ent->r.maxs, ent->client->unlaggedBackup.maxs );
 		VectorCopy( ent->r.currentOrigin, ent->client->unlaggedBackup.origin );
 		ent->client->unlaggedBackup.used = true;
+		level.unlaggedMovedClients[ level.numUnlaggedMovedClients++ ] = ent->s.number;
 
 		// move the client to the calculated unlagged position
 		VectorCopy( calc->mins, ent->r.mins );
@@ -1631,10 +1663,15 @@ static void G_UnlaggedDetectCollisions( gentity_t *ent )
  */
 static int FindAlienHealthSource( gentity_t *self )
 {
-	int       ret = 0, closeTeammates = 0;
-	float     distance, minBoosterDistance = FLT_MAX;
-	bool      needsHealing;
-	gentity_t *ent;
+	static float   maxSourceRange = 0.0f;
+	int            ret = 0, closeTeammates = 0;
+	float          distance, minBoosterDistance = FLT_MAX;
+	bool           needsHealing;
+	gentity_t      *ent;
+	gentity_t      *sources[ MAX_GENTITIES ];
+	int            numSources;
+	vec3_t         mins, maxs;
+	entityFilter_t filter;
 
 	if ( !self || !self->client )
 	{
@@ -1645,8 +1682,30 @@ static int FindAlienHealthSource( gentity_t *self )
 
 	self->boosterUsed = nullptr;
 
-	for ( ent = nullptr; ( ent = G_IterateEntities( ent, nullptr, true, 0, nullptr ) ); )
+	// the farthest any health source can reach
+	if ( !maxSourceRange )
 	{
+		maxSourceRange = std::max( { REGEN_TEAMMATE_RANGE, REGEN_BOOSTER_RANGE, ( float ) CREEP_BASESIZE } );
+
+		for ( int i = BA_NONE + 1; i < BA_NUM_BUILDABLES; i++ )
+		{
+			maxSourceRange = std::max( maxSourceRange, ( float ) BG_Buildable( i )->creepSize );
+		}
+	}
+
+	for ( int i = 0; i < 3; i++ )
+	{
+		mins[ i ] = self->s.origin[ i ] - maxSourceRange;
+		maxs[ i ] = self->s.origin[ i ] + maxSourceRange;
+	}
+
+	filter.team = G_Team( self );
+	numSources = G_EntitiesInBox( mins, maxs, sources, MAX_GENTITIES, filter );
+
+	for ( int i = 0; i < numSources; i++ )
+	{
+		ent = sources[ i ];
+
 		if ( !G_OnSameTeam( self, ent ) ) continue;
 		if ( Entities::IsDead( ent ) )              continue;
 
@@ -2059,7 +2118,9 @@ void ClientThink_real( gentity_t *self )
 	// Do this before Pmove because it is shared code and accesses networked fields.
 	G_PrepareEntityNetCode();
 
+	G_PmoveRecordStart( &pm );
 	Pmove( &pm );
+	G_PmoveRecordFinish( &pm );
 
 	G_UnlaggedDetectCollisions( self );
 
@@ -2190,7 +2251,7 @@ void ClientThink_real( gentity_t *self )
 
 		if ( ent && ent->use &&
 		     ( !ent->buildableTeam   || ent->buildableTeam   == client->pers.team ) &&
-		     ( !ent->conditions.team || ent->conditions.team == client->pers.team ) )
+		     ( !ent->script || !ent->script->conditions.team || ent->script->conditions.team == client->pers.team ) )
 		{
 			if ( g_debugEntities.integer > 1 )
 			{
@@ -2202,10 +2263,17 @@ void ClientThink_real( gentity_t *self )
 		else
 		{
 			// no entity in front of player - do a small area search
-			for ( ent = nullptr; ( ent = G_IterateEntitiesWithinRadius( ent, client->ps.origin, ENTITY_USE_RANGE ) ); )
+			gentity_t *neighbors[ MAX_GENTITIES ];
+			int numNeighbors = G_EntitiesWithinRadius( client->ps.origin, ENTITY_USE_RANGE, neighbors, MAX_GENTITIES );
+
+			ent = nullptr;
+
+			for ( int i = 0; i < numNeighbors; i++ )
 			{
-				if ( ent && ent->use && ent->buildableTeam == client->pers.team)
+				if ( neighbors[ i ]->use && neighbors[ i ]->buildableTeam == client->pers.team )
 				{
+					ent = neighbors[ i ];
+
 					if ( g_debugEntities.integer > 1 )
 					{
 						Log::Debug("Calling entity->use after an area-search for %s", etos(ent));
@@ -2258,6 +2326,7 @@ void ClientThink( int clientNum )
 
 	if(!( ent->r.svFlags & SVF_BOT ) && !level.pmoveParams.synchronous )
 	{
+		G_ProfileScope profile( PROFILE_CLIENT_THINK );
 		ClientThink_real( ent );
 	}
 }
@@ -30,6 +30,20 @@ Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
 static botMemory_t g_botMind[MAX_CLIENTS];
 static AITreeList_t treeList;
 
+static Cvar::Cvar<int> g_bot_thinkInterval(
+	"g_bot_thinkInterval", "minimum msec between two full thinks of a bot, bots still move every frame", Cvar::NONE, 0);
+static Cvar::Cvar<bool> g_bot_compiledTrees(
+	"g_bot_compiledTrees", "run the compiled form of the behavior trees", Cvar::NONE, true);
+static Cvar::Cvar<int> g_bot_thinkBudget(
+	"g_bot_thinkBudget", "microseconds all bots may spend on full thinks per frame, 0 for no limit", Cvar::NONE, 0);
+
+// time spent on full thinks during the current frame
+static struct
+{
+	int     frame;
+	int64_t usecUsed;
+} botThinkBudget;
+
 /*
 =======================
 Bot management functions
@@ -191,6 +205,8 @@ bool G_BotSetDefaults( int clientNum, team_t team, int skill, const char* behavi
 	botMind->currentNode = nullptr;
 	memset( &botMind->nav, 0, sizeof( botMind->nav ) );
 	BotResetEnemyQueue( &botMind->enemyQueue );
+	botMind->thinkPeriod = -1;
+	botMind->thinkDeferred = false;
 
 	botMind->behaviorTree = ReadBehaviorTree( behavior, &treeList );
 
@@ -361,6 +377,53 @@ Bot Thinks
 =======================
 */
 
+/*
+ * Whether the bot runs its perception, path and behavior tree this frame.
+ *
+ * Full thinks are spaced by g_bot_thinkInterval, with bots spread over the
+ * interval so that they don't all think on the same frame, and stop for the
+ * frame once g_bot_thinkBudget is used up. A bot that was postponed for lack
+ * of budget always thinks on its next frame so none of them can starve.
+ */
+static bool G_BotThinkIsDue( gentity_t *self )
+{
+	botMemory_t *mind = self->botMind;
+	int         interval = g_bot_thinkInterval.Get();
+	int         budget = g_bot_thinkBudget.Get();
+
+	if ( botThinkBudget.frame != level.framenum )
+	{
+		botThinkBudget.frame = level.framenum;
+		botThinkBudget.usecUsed = 0;
+	}
+
+	// each bot thinks once per period of the interval, at its own offset into it,
+	// which follows changes of the interval since nothing of it is kept
+	int period = -1;
+
+	if ( interval > 0 )
+	{
+		int phase = interval * self->s.number / MAX_CLIENTS;
+
+		period = ( level.time + interval - phase ) / interval;
+
+		if ( period == mind->thinkPeriod )
+		{
+			return false;
+		}
+	}
+
+	if ( budget > 0 && botThinkBudget.usecUsed >= budget && !mind->thinkDeferred )
+	{
+		mind->thinkDeferred = true;
+		return false;
+	}
+
+	mind->thinkDeferred = false;
+	mind->thinkPeriod = period;
+	return true;
+}
+
 void G_BotThink( gentity_t *self )
 {
 	char buf[MAX_STRING_CHARS];
@@ -368,6 +431,23 @@ void G_BotThink( gentity_t *self )
 	vec3_t     nudge;
 	botRouteTarget_t routeTarget;
 
+	//acknowledge recieved server commands
+	//MUST be done
+	while ( trap_BotGetServerCommand( self->client->ps.clientNum, buf, sizeof( buf ) ) );
+
+	//hacky ping fix
+	self->client->ps.ping = rand() % 50 + 50;
+
+	if ( !G_BotThinkIsDue( self ) )
+	{
+		// keep moving and aiming as decided on the last think,
+		// but don't repeat one-shot actions
+		self->client->pers.cmd.doubleTap = dtType_t::DT_NONE;
+		return;
+	}
+
+	Sys::SteadyClock::time_point thinkStart = Sys::SteadyClock::now();
+
 	self->botMind->cmdBuffer = self->client->pers.cmd;
 	botCmdBuffer = &self->botMind->cmdBuffer;
 
@@ -384,10 +464,6 @@ void G_BotThink( gentity_t *self )
 	botCmdBuffer->upmove = 0;
 	botCmdBuffer->doubleTap = dtType_t::DT_NONE;
 
-	//acknowledge recieved server commands
-	//MUST be done
-	while ( trap_BotGetServerCommand( self->client->ps.clientNum, buf, sizeof( buf ) ) );
-
 	BotSearchForEnemy( self );
 	BotFindClosestBuildings( self );
 	BotFindDamagedFriendlyStructure( self );
@@ -406,29 +482,31 @@ void G_BotThink( gentity_t *self )
 		G_AddCreditToClient( self->client, HUMAN_MAX_CREDITS, true );
 	}
 
-	//hacky ping fix
-	self->client->ps.ping = rand() % 50 + 50;
-
 	if ( !self->botMind->behaviorTree )
 	{
 		Log::Warn( "NULL behavior tree" );
-		return;
 	}
-
-	// always update the path corridor
-	if ( self->botMind->goal.inuse )
+	else
 	{
-		BotTargetToRouteTarget( self, self->botMind->goal, &routeTarget );
-		trap_BotUpdatePath( self->s.number, &routeTarget, &self->botMind->nav );
-		//BotClampPos( self );
-	}
+		// always update the path corridor
+		if ( self->botMind->goal.inuse )
+		{
+			BotTargetToRouteTarget( self, self->botMind->goal, &routeTarget );
+			trap_BotUpdatePath( self->s.number, &routeTarget, &self->botMind->nav );
+			//BotClampPos( self );
+		}
+
+		BotRunBehaviorTree( self, self->botMind->behaviorTree, g_bot_compiledTrees.Get() );
 
-	self->botMind->behaviorTree->run( self, ( AIGenericNode_t * ) self->botMind->behaviorTree );
+		// if we were nudged...
+		VectorAdd( self->client->ps.velocity, nudge, self->client->ps.velocity );
 
-	// if we were nudged...
-	VectorAdd( self->client->ps.velocity, nudge, self->client->ps.velocity );
+		self->client->pers.cmd = self->botMind->cmdBuffer;
+	}
 
-	self->client->pers.cmd = self->botMind->cmdBuffer;
+	// the sensing above counts even without a tree
+	botThinkBudget.usecUsed += std::chrono::duration_cast<std::chrono::microseconds>(
+		Sys::SteadyClock::now() - thinkStart ).count();
 }
 
 void G_BotSpectatorThink( gentity_t *self )
@@ -521,6 +599,93 @@ void G_BotInit()
 	}
 }
 
+/*
+=======================
+G_BotTreeBenchmark_f
+
+Ticks the behavior tree of every bot in game with both interpreters and
+reports the nodes evaluated per second. The state of the bots, including
+their timers, is restored after each pass so both start alike, but actions
+still take effect, so use it on a test server.
+=======================
+*/
+void G_BotTreeBenchmark_f()
+{
+	char arg[ 16 ];
+	int  ticks = 1000;
+	std::vector<gentity_t *> bots;
+
+	if ( trap_Argc() > 1 )
+	{
+		trap_Argv( 1, arg, sizeof( arg ) );
+		ticks = std::max( 1, atoi( arg ) );
+	}
+
+	for ( int i = 0; i < level.maxclients; i++ )
+	{
+		gentity_t *bot = &g_entities[ i ];
+
+		if ( bot->inuse && ( bot->r.svFlags & SVF_BOT ) && bot->botMind && bot->botMind->behaviorTree &&
+		     bot->botMind->behaviorTree->compiled && bot->client->sess.spectatorState == SPECTATOR_NOT )
+		{
+			bots.push_back( bot );
+		}
+	}
+
+	if ( bots.empty() )
+	{
+		Log::Notice( "no bots in game" );
+		return;
+	}
+
+	for ( bool compiled : { false, true } )
+	{
+		int64_t nodes = botNodesEvaluated;
+		Sys::SteadyClock::time_point start = Sys::SteadyClock::now();
+
+		for ( gentity_t *bot : bots )
+		{
+			AIBehaviorTree_t *tree = bot->botMind->behaviorTree;
+			botMemory_t      mind = *bot->botMind;
+			playerState_t    ps = bot->client->ps;
+			usercmd_t        cmd = bot->client->pers.cmd;
+
+			// timers keep their per-bot state in the parsed nodes, which both interpreters share
+			std::vector<std::pair<AIDecoratorNode_t *, int>> timers;
+
+			for ( const AICompiledNode_t &node : tree->compiled->nodes )
+			{
+				if ( node.op == CNODE_TIMER )
+				{
+					AIDecoratorNode_t *dec = ( AIDecoratorNode_t * ) node.source;
+					timers.emplace_back( dec, dec->data[ bot->s.number ] );
+				}
+			}
+
+			for ( int tick = 0; tick < ticks; tick++ )
+			{
+				BotRunBehaviorTree( bot, tree, compiled );
+			}
+
+			*bot->botMind = mind;
+			bot->client->ps = ps;
+			bot->client->pers.cmd = cmd;
+
+			for ( const std::pair<AIDecoratorNode_t *, int> &timer : timers )
+			{
+				timer.first->data[ bot->s.number ] = timer.second;
+			}
+		}
+
+		float seconds = std::chrono::duration<float>( Sys::SteadyClock::now() - start ).count();
+		nodes = botNodesEvaluated - nodes;
+
+		Log::Notice( "%s: %d bots x %d ticks, %d nodes in %.3fs, %.0f nodes/s",
+		             compiled ? "compiled" : "interpreted", (int) bots.size(), ticks, (int) nodes,
+		             seconds, seconds > 0.0f ? nodes / seconds : 0.0f );
+	}
+}
+
 void G_BotCleanup()
 {
 	for ( int i = 0; i < MAX_CLIENTS; ++i )
@@ -92,6 +92,8 @@ struct botMemory_t
 	botNavCmd_t nav;
 
 	int lastThink;
+	int thinkPeriod;   // the g_bot_thinkInterval period of the last full think, see G_BotThinkIsDue
+	bool thinkDeferred; // the last full think was postponed for lack of budget
 	int stuckTime;
 	vec3_t stuckPosition;
 };
@@ -114,5 +116,6 @@ void     G_BotDisableArea( vec3_t origin, vec3_t mins, vec3_t maxs );
 void     G_BotEnableArea( vec3_t origin, vec3_t mins, vec3_t maxs );
 void     G_BotInit();
 void     G_BotCleanup();
+void     G_BotTreeBenchmark_f();
 void G_BotFill( bool immediately );
 #endif
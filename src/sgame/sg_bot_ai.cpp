@@ -39,6 +39,8 @@ The return values are used in various sequences and selectors to change the exec
 ======================
 */
 
+int64_t botNodesEvaluated;
+
 bool isBinaryOp( AIOpType_t op )
 {
 	switch ( op )
@@ -463,17 +465,13 @@ AINodeStatus_t BotBehaviorNode( gentity_t *self, AIGenericNode_t *node )
 
 /*
 ======================
-BotEvaluateNode
+BotUpdateRunningNodes
 
-Generic node running routine that properly handles 
-running information for sequences and selectors
-This should always be used instead of the node->run function pointer
+Records the status of a node that has just been run
 ======================
 */
-AINodeStatus_t BotEvaluateNode( gentity_t *self, AIGenericNode_t *node )
+static AINodeStatus_t BotUpdateRunningNodes( gentity_t *self, AIGenericNode_t *node, AINodeStatus_t status )
 {
-	AINodeStatus_t status = node->run( self, node );
-
 	// reset the current node if it finishes
 	// we do this so we can re-pathfind on the next entrance
 	if ( ( status == STATUS_SUCCESS || status == STATUS_FAILURE ) && self->botMind->currentNode == node )
@@ -514,6 +512,186 @@ AINodeStatus_t BotEvaluateNode( gentity_t *self, AIGenericNode_t *node )
 	return status;
 }
 
+/*
+======================
+BotEvaluateNode
+
+Generic node running routine that properly handles 
+running information for sequences and selectors
+This should always be used instead of the node->run function pointer
+======================
+*/
+AINodeStatus_t BotEvaluateNode( gentity_t *self, AIGenericNode_t *node )
+{
+	botNodesEvaluated++;
+	return BotUpdateRunningNodes( self, node, node->run( self, node ) );
+}
+
+/*
+======================
+Compiled tree interpreter
+
+Mirrors the node functions above over the arrays of a compiled tree
+======================
+*/
+static double EvalCompiledExp( gentity_t *self, const AICompiledTree_t *tree, int index )
+{
+	const AICompiledExp_t *exp = &tree->exps[ index ];
+
+	switch ( exp->op )
+	{
+		case CEXP_CONST:
+			return exp->value;
+		case CEXP_FUNC:
+		{
+			AIValue_t vt = exp->func( self, exp->params );
+			double vd = AIUnBoxDouble( vt );
+			AIDestroyValue( vt );
+			return vd;
+		}
+		case CEXP_NOT:
+			return EvalCompiledExp( self, tree, exp->exp1 ) == 0.0;
+		case CEXP_LESSTHAN:
+			return EvalCompiledExp( self, tree, exp->exp1 ) < EvalCompiledExp( self, tree, exp->exp2 );
+		case CEXP_LESSTHANEQUAL:
+			return EvalCompiledExp( self, tree, exp->exp1 ) <= EvalCompiledExp( self, tree, exp->exp2 );
+		case CEXP_GREATERTHAN:
+			return EvalCompiledExp( self, tree, exp->exp1 ) > EvalCompiledExp( self, tree, exp->exp2 );
+		case CEXP_GREATERTHANEQUAL:
+			return EvalCompiledExp( self, tree, exp->exp1 ) >= EvalCompiledExp( self, tree, exp->exp2 );
+		case CEXP_EQUAL:
+			return EvalCompiledExp( self, tree, exp->exp1 ) == EvalCompiledExp( self, tree, exp->exp2 );
+		case CEXP_NEQUAL:
+			return EvalCompiledExp( self, tree, exp->exp1 ) != EvalCompiledExp( self, tree, exp->exp2 );
+		case CEXP_AND:
+			return EvalCompiledExp( self, tree, exp->exp1 ) != 0.0 && EvalCompiledExp( self, tree, exp->exp2 ) != 0.0;
+		case CEXP_OR:
+			return EvalCompiledExp( self, tree, exp->exp1 ) != 0.0 || EvalCompiledExp( self, tree, exp->exp2 ) != 0.0;
+	}
+
+	return 0.0;
+}
+
+static AINodeStatus_t BotEvaluateCompiledNode( gentity_t *self, const AICompiledTree_t *tree, int index )
+{
+	const AICompiledNode_t *node = &tree->nodes[ index ];
+	const int              *children = tree->children.data() + node->firstChild;
+	AINodeStatus_t         status = STATUS_FAILURE;
+	int                    i;
+
+	switch ( node->op )
+	{
+		case CNODE_SELECTOR:
+			for ( i = 0; i < node->numChildren; i++ )
+			{
+				status = BotEvaluateCompiledNode( self, tree, children[ i ] );
+
+				if ( status != STATUS_FAILURE )
+				{
+					break;
+				}
+			}
+			break;
+
+		case CNODE_SEQUENCE:
+			// find a previously running node and start there
+			for ( i = node->numChildren - 1; i > 0; i-- )
+			{
+				if ( NodeIsRunning( self, tree->nodes[ children[ i ] ].source ) )
+				{
+					break;
+				}
+			}
+
+			i = std::max( i, 0 );
+			status = STATUS_SUCCESS;
+
+			for ( ; i < node->numChildren; i++ )
+			{
+				status = BotEvaluateCompiledNode( self, tree, children[ i ] );
+
+				if ( status != STATUS_SUCCESS )
+				{
+					break;
+				}
+			}
+			break;
+
+		case CNODE_CONCURRENT:
+			status = STATUS_SUCCESS;
+
+			for ( i = 0; i < node->numChildren; i++ )
+			{
+				if ( BotEvaluateCompiledNode( self, tree, children[ i ] ) == STATUS_FAILURE )
+				{
+					status = STATUS_FAILURE;
+					break;
+				}
+			}
+			break;
+
+		case CNODE_CONDITION:
+			if ( EvalCompiledExp( self, tree, node->exp ) != 0.0 )
+			{
+				status = node->numChildren ? BotEvaluateCompiledNode( self, tree, children[ 0 ] ) : STATUS_SUCCESS;
+			}
+			break;
+
+		case CNODE_TIMER:
+		{
+			AIDecoratorNode_t *dec = ( AIDecoratorNode_t * ) node->source;
+
+			if ( level.time > dec->data[ self->s.number ] )
+			{
+				status = BotEvaluateCompiledNode( self, tree, children[ 0 ] );
+
+				if ( status == STATUS_FAILURE )
+				{
+					dec->data[ self->s.number ] = level.time + node->param;
+				}
+			}
+			break;
+		}
+
+		case CNODE_RETURN:
+			BotEvaluateCompiledNode( self, tree, children[ 0 ] );
+			status = ( AINodeStatus_t ) node->param;
+			break;
+
+		case CNODE_BEHAVIOR:
+			status = BotEvaluateCompiledNode( self, tree, children[ 0 ] );
+			break;
+
+		case CNODE_ACTION:
+			status = node->run( self, node->source );
+			break;
+
+		case CNODE_NATIVE:
+			return BotEvaluateNode( self, node->source );
+	}
+
+	botNodesEvaluated++;
+	return BotUpdateRunningNodes( self, node->source, status );
+}
+
+/*
+======================
+BotRunBehaviorTree
+
+Runs the root of a behavior tree, through its compiled form if asked and available
+======================
+*/
+AINodeStatus_t BotRunBehaviorTree( gentity_t *self, AIBehaviorTree_t *tree, bool compiled )
+{
+	if ( compiled && tree->compiled )
+	{
+		const AICompiledNode_t &root = tree->compiled->nodes[ 0 ];
+		return BotEvaluateCompiledNode( self, tree->compiled, tree->compiled->children[ root.firstChild ] );
+	}
+
+	return tree->run( self, ( AIGenericNode_t * ) tree );
+}
+
 /*
 ======================
 Action Nodes
@@ -96,12 +96,15 @@ struct AINodeList_t
 	int numNodes;
 };
 
+struct AICompiledTree_t;
+
 struct AIBehaviorTree_t
 {
 	AINode_t     type;
 	AINodeRunner run;
 	char name[ MAX_QPATH ];
 	AIGenericNode_t *root;
+	AICompiledTree_t *compiled;
 };
 
 // operations used in condition nodes
@@ -208,6 +211,77 @@ struct AIActionNode_t
 	int          nparams;
 };
 
+/*
+======================
+Compiled behavior trees
+
+A parsed tree is lowered into arrays of nodes and condition expressions that
+refer to each other by index, with included trees inlined, constants unboxed
+and the node functions resolved to an opcode. Each compiled node keeps the
+parsed node it comes from, which remains its identity for the running state
+of the bot and holds the per-bot data of decorators.
+======================
+*/
+enum AICompiledNodeOp_t : uint8_t
+{
+	CNODE_SELECTOR,
+	CNODE_SEQUENCE,
+	CNODE_CONCURRENT,
+	CNODE_CONDITION,
+	CNODE_TIMER,
+	CNODE_RETURN,
+	CNODE_BEHAVIOR,
+	CNODE_ACTION,
+	CNODE_NATIVE // anything else, run through the parsed node
+};
+
+struct AICompiledNode_t
+{
+	AICompiledNodeOp_t op;
+	int                numChildren;
+	int                firstChild; // in AICompiledTree_t::children
+	int                exp;        // condition, in AICompiledTree_t::exps
+	int                param;      // timer period or returned status
+	AINodeRunner       run;        // action
+	AIGenericNode_t    *source;
+};
+
+enum AICompiledExpOp_t : uint8_t
+{
+	CEXP_CONST,
+	CEXP_FUNC,
+	CEXP_NOT,
+	CEXP_LESSTHAN,
+	CEXP_LESSTHANEQUAL,
+	CEXP_GREATERTHAN,
+	CEXP_GREATERTHANEQUAL,
+	CEXP_EQUAL,
+	CEXP_NEQUAL,
+	CEXP_AND,
+	CEXP_OR
+};
+
+struct AICompiledExp_t
+{
+	AICompiledExpOp_t op;
+	int               exp1, exp2; // operands, in AICompiledTree_t::exps
+	double            value;
+	AIFunc            func;
+	const AIValue_t   *params;
+};
+
+struct AICompiledTree_t
+{
+	std::vector<AICompiledNode_t> nodes; // nodes[ 0 ] is the tree itself
+	std::vector<int>              children;
+	std::vector<AICompiledExp_t>  exps;
+};
+
+// number of nodes evaluated by either interpreter, for benchmarking
+extern int64_t botNodesEvaluated;
+
+AINodeStatus_t BotRunBehaviorTree( gentity_t *self, AIBehaviorTree_t *tree, bool compiled );
+
 bool isBinaryOp( AIOpType_t op );
 bool isUnaryOp( AIOpType_t op );
 
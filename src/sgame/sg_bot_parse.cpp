@@ -1357,6 +1357,7 @@ AIBehaviorTree_t *ReadBehaviorTree( const char *name, AITreeList_t *list )
 	if ( node )
 	{
 		tree->root = node;
+		tree->compiled = CompileBehaviorTree( tree );
 	}
 	else
 	{
@@ -1368,6 +1369,147 @@ AIBehaviorTree_t *ReadBehaviorTree( const char *name, AITreeList_t *list )
 	return tree;
 }
 
+/*
+======================
+CompileBehaviorTree
+
+Lowers a parsed behavior tree into the arrays run by BotRunBehaviorTree
+Operands and children are stored after their parent
+======================
+*/
+
+static int CompileExpression( AICompiledTree_t *tree, AIExpType_t *exp )
+{
+	AICompiledExp_t compiled{};
+	int index = tree->exps.size();
+
+	tree->exps.emplace_back();
+
+	compiled.op = CEXP_CONST;
+
+	if ( *exp == EX_VALUE )
+	{
+		compiled.value = AIUnBoxDouble( *( AIValue_t * ) exp );
+	}
+	else if ( *exp == EX_FUNC )
+	{
+		AIValueFunc_t *v = ( AIValueFunc_t * ) exp;
+
+		compiled.op = CEXP_FUNC;
+		compiled.func = v->func;
+		compiled.params = v->params;
+	}
+	else if ( *exp == EX_OP )
+	{
+		AIOp_t *op = ( AIOp_t * ) exp;
+
+		if ( isBinaryOp( op->opType ) )
+		{
+			AIBinaryOp_t *b = ( AIBinaryOp_t * ) op;
+
+			switch ( op->opType )
+			{
+				case OP_LESSTHAN:         compiled.op = CEXP_LESSTHAN;         break;
+				case OP_LESSTHANEQUAL:    compiled.op = CEXP_LESSTHANEQUAL;    break;
+				case OP_GREATERTHAN:      compiled.op = CEXP_GREATERTHAN;      break;
+				case OP_GREATERTHANEQUAL: compiled.op = CEXP_GREATERTHANEQUAL; break;
+				case OP_EQUAL:            compiled.op = CEXP_EQUAL;            break;
+				case OP_NEQUAL:           compiled.op = CEXP_NEQUAL;           break;
+				case OP_AND:              compiled.op = CEXP_AND;              break;
+				default:                  compiled.op = CEXP_OR;               break;
+			}
+
+			compiled.exp1 = CompileExpression( tree, b->exp1 );
+			compiled.exp2 = CompileExpression( tree, b->exp2 );
+		}
+		else if ( isUnaryOp( op->opType ) )
+		{
+			AIUnaryOp_t *u = ( AIUnaryOp_t * ) op;
+
+			compiled.op = CEXP_NOT;
+			compiled.exp1 = CompileExpression( tree, u->exp );
+		}
+	}
+
+	tree->exps[ index ] = compiled;
+	return index;
+}
+
+static int CompileNode( AICompiledTree_t *tree, AIGenericNode_t *node )
+{
+	AICompiledNode_t               compiled{};
+	std::vector<AIGenericNode_t *> children;
+	std::vector<int>               childIndices;
+	int                            index = tree->nodes.size();
+
+	tree->nodes.emplace_back();
+
+	compiled.source = node;
+
+	if ( node->run == BotSelectorNode || node->run == BotSequenceNode || node->run == BotConcurrentNode )
+	{
+		AINodeList_t *list = ( AINodeList_t * ) node;
+
+		compiled.op = node->run == BotSelectorNode ? CNODE_SELECTOR :
+		              node->run == BotSequenceNode ? CNODE_SEQUENCE : CNODE_CONCURRENT;
+		children.assign( list->list, list->list + list->numNodes );
+	}
+	else if ( node->run == BotConditionNode )
+	{
+		AIConditionNode_t *con = ( AIConditionNode_t * ) node;
+
+		compiled.op = CNODE_CONDITION;
+		compiled.exp = CompileExpression( tree, con->exp );
+
+		if ( con->child )
+		{
+			children.push_back( con->child );
+		}
+	}
+	else if ( node->run == BotDecoratorTimer || node->run == BotDecoratorReturn )
+	{
+		AIDecoratorNode_t *dec = ( AIDecoratorNode_t * ) node;
+
+		compiled.op = node->run == BotDecoratorTimer ? CNODE_TIMER : CNODE_RETURN;
+		compiled.param = AIUnBoxInt( dec->params[ 0 ] );
+		children.push_back( dec->child );
+	}
+	else if ( node->run == BotBehaviorNode )
+	{
+		compiled.op = CNODE_BEHAVIOR;
+		children.push_back( ( ( AIBehaviorTree_t * ) node )->root );
+	}
+	else if ( node->type == ACTION_NODE )
+	{
+		compiled.op = CNODE_ACTION;
+		compiled.run = node->run;
+	}
+	else
+	{
+		compiled.op = CNODE_NATIVE;
+	}
+
+	for ( AIGenericNode_t *child : children )
+	{
+		childIndices.push_back( CompileNode( tree, child ) );
+	}
+
+	compiled.firstChild = tree->children.size();
+	compiled.numChildren = childIndices.size();
+	tree->children.insert( tree->children.end(), childIndices.begin(), childIndices.end() );
+
+	tree->nodes[ index ] = compiled;
+	return index;
+}
+
+AICompiledTree_t *CompileBehaviorTree( AIBehaviorTree_t *tree )
+{
+	AICompiledTree_t *compiled = new AICompiledTree_t;
+
+	CompileNode( compiled, ( AIGenericNode_t * ) tree );
+	return compiled;
+}
+
 pc_token_list *CreateTokenList( int handle )
 {
 	pc_token_t token;
@@ -1614,6 +1756,7 @@ void FreeBehaviorTree( AIBehaviorTree_t *tree )
 	if ( tree )
 	{
 		FreeNode(tree->root);
+		delete tree->compiled;
 
 		BG_Free( tree );
 	}
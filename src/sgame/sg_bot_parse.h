@@ -83,6 +83,7 @@ AIGenericNode_t  *ReadConditionNode( pc_token_list **tokenlist );
 AIGenericNode_t  *ReadActionNode( pc_token_list **tokenlist );
 AIGenericNode_t  *ReadNodeList( pc_token_list **tokenlist );
 AIBehaviorTree_t *ReadBehaviorTree( const char *name, AITreeList_t *list );
+AICompiledTree_t *CompileBehaviorTree( AIBehaviorTree_t *tree );
 
 void FreeBehaviorTree( AIBehaviorTree_t *tree );
 void FreeActionNode( AIActionNode_t *action );
@@ -431,28 +431,159 @@ void BotGetDesiredBuy( gentity_t *self, weapon_t *weapon, upgrade_t *upgrades, i
 	}
 }
 
+/*
+=======================
+Perception snapshot
+
+The entities bots look for are gathered once per frame, so that every bot
+searches short lists instead of walking all of g_entities. Only which entities
+are candidates is shared: their state is still checked when they are used, as
+it can change while the frame runs.
+=======================
+*/
+
+// cells are larger than the sense range so that the 3x3 cells around a bot
+// still hold every enemy in range after they moved during the frame
+#define PERCEPTION_CELL_SIZE ( ALIENSENSE_RANGE + 256.0f )
+#define PERCEPTION_BUCKETS   256
+
+static struct
+{
+	int                     time;
+	int                     frame;
+	std::vector<gentity_t*> buildablesByType[ BA_NUM_BUILDABLES ];
+	std::vector<gentity_t*> buildablesByTeam[ NUM_TEAMS ];
+	std::vector<gentity_t*> targets[ PERCEPTION_BUCKETS ]; // players and buildables of a team, hashed by cell
+} perception = { -1, -1 };
+
+static int BotPerceptionCell( float coord )
+{
+	return ( int ) floorf( coord / PERCEPTION_CELL_SIZE );
+}
+
+static int BotPerceptionBucket( int x, int y )
+{
+	return ( ( x * 73856093 ) ^ ( y * 19349663 ) ) & ( PERCEPTION_BUCKETS - 1 );
+}
+
+static void BotUpdatePerception()
+{
+	gentity_t *ent;
+	int       i;
+
+	if ( perception.time == level.time && perception.frame == level.framenum )
+	{
+		return;
+	}
+
+	perception.time = level.time;
+	perception.frame = level.framenum;
+
+	for ( auto &list : perception.buildablesByType ) list.clear();
+	for ( auto &list : perception.buildablesByTeam ) list.clear();
+	for ( auto &list : perception.targets ) list.clear();
+
+	for ( i = 0, ent = g_entities; i < level.num_entities; i++, ent++ )
+	{
+		if ( !ent->inuse )
+		{
+			continue;
+		}
+
+		if ( ent->s.eType == entityType_t::ET_BUILDABLE )
+		{
+			if ( ent->s.modelindex > BA_NONE && ent->s.modelindex < BA_NUM_BUILDABLES )
+			{
+				perception.buildablesByType[ ent->s.modelindex ].push_back( ent );
+			}
+
+			perception.buildablesByTeam[ ent->buildableTeam ].push_back( ent );
+		}
+		else if ( !ent->client )
+		{
+			continue;
+		}
+
+		if ( BotGetEntityTeam( ent ) == TEAM_NONE )
+		{
+			continue;
+		}
+
+		int bucket = BotPerceptionBucket( BotPerceptionCell( ent->s.origin[ 0 ] ),
+		                                  BotPerceptionCell( ent->s.origin[ 1 ] ) );
+		perception.targets[ bucket ].push_back( ent );
+	}
+}
+
+/*
+ * Calls func for every player or buildable with a team that can be within
+ * ALIENSENSE_RANGE of origin, and for some that are farther away.
+ */
+template<typename Func>
+static void BotForTargetsNear( const vec3_t origin, Func&& func )
+{
+	int buckets[ 9 ];
+	int numBuckets = 0;
+	int cx = BotPerceptionCell( origin[ 0 ] );
+	int cy = BotPerceptionCell( origin[ 1 ] );
+
+	BotUpdatePerception();
+
+	for ( int x = cx - 1; x <= cx + 1; x++ )
+	{
+		for ( int y = cy - 1; y <= cy + 1; y++ )
+		{
+			int bucket = BotPerceptionBucket( x, y );
+
+			// neighbouring cells may share a bucket
+			if ( std::find( buckets, buckets + numBuckets, bucket ) != buckets + numBuckets )
+			{
+				continue;
+			}
+
+			buckets[ numBuckets++ ] = bucket;
+
+			for ( gentity_t *target : perception.targets[ bucket ] )
+			{
+				func( target );
+			}
+		}
+	}
+}
+
 /*
 =======================
 Entity Querys
 =======================
 */
 
+// the buildable may have been freed or replaced since the snapshot was taken
+static bool BotIsBuildable( gentity_t *ent )
+{
+	return ent->inuse && ent->s.eType == entityType_t::ET_BUILDABLE;
+}
+
 gentity_t* BotFindBuilding( gentity_t *self, int buildingType, int range )
 {
 	float minDistance = -1;
 	gentity_t* closestBuilding = nullptr;
 	float newDistance;
 	float rangeSquared = Square( range );
-	gentity_t *target = &g_entities[MAX_CLIENTS];
-	int i;
 
-	for ( i = MAX_CLIENTS; i < level.num_entities; i++, target++ )
+	if ( buildingType <= BA_NONE || buildingType >= BA_NUM_BUILDABLES )
 	{
-		if ( !target->inuse )
+		return nullptr;
+	}
+
+	BotUpdatePerception();
+
+	for ( gentity_t *target : perception.buildablesByType[ buildingType ] )
+	{
+		if ( !BotIsBuildable( target ) )
 		{
 			continue;
 		}
-		if ( target->s.eType == entityType_t::ET_BUILDABLE && target->s.modelindex == buildingType &&
+		if ( target->s.modelindex == buildingType &&
 		     ( target->buildableTeam == TEAM_ALIENS || ( target->powered && target->spawned ) ) &&
 		     Entities::IsAlive( target ) )
 		{
@@ -473,7 +604,6 @@ gentity_t* BotFindBuilding( gentity_t *self, int buildingType, int range )
 
 void BotFindClosestBuildings( gentity_t *self )
 {
-	gentity_t *testEnt;
 	botEntityAndDistance_t *ent;
 
 	// clear out building list
@@ -483,41 +613,41 @@ void BotFindClosestBuildings( gentity_t *self )
 		self->botMind->closestBuildings[ i ].distance = INT_MAX;
 	}
 
-	for ( testEnt = &g_entities[MAX_CLIENTS]; testEnt < &g_entities[level.num_entities - 1]; testEnt++ )
+	BotUpdatePerception();
+
+	for ( const auto &buildables : perception.buildablesByType )
 	{
-		float newDist;
-		//ignore entities that arnt in use
-		if ( !testEnt->inuse )
+		for ( gentity_t *testEnt : buildables )
 		{
-			continue;
-		}
+			float newDist;
 
-		//skip non buildings
-		if ( testEnt->s.eType != entityType_t::ET_BUILDABLE )
-		{
-			continue;
-		}
+			//ignore entities that were freed since the snapshot
+			if ( !BotIsBuildable( testEnt ) )
+			{
+				continue;
+			}
 
-		//ignore dead targets
-		if ( Entities::IsDead( testEnt ) )
-		{
-			continue;
-		}
+			//ignore dead targets
+			if ( Entities::IsDead( testEnt ) )
+			{
+				continue;
+			}
 
-		//skip human buildings that are currently building or arn't powered
-		if ( testEnt->buildableTeam == TEAM_HUMANS && ( !testEnt->powered || !testEnt->spawned ) )
-		{
-			continue;
-		}
+			//skip human buildings that are currently building or arn't powered
+			if ( testEnt->buildableTeam == TEAM_HUMANS && ( !testEnt->powered || !testEnt->spawned ) )
+			{
+				continue;
+			}
 
-		newDist = Distance( self->s.origin, testEnt->s.origin );
+			newDist = Distance( self->s.origin, testEnt->s.origin );
 
-		ent = &self->botMind->closestBuildings[ testEnt->s.modelindex ];
+			ent = &self->botMind->closestBuildings[ testEnt->s.modelindex ];
 
-		if ( newDist < ent->distance )
-		{
-			ent->ent = testEnt;
-			ent->distance = newDist;
+			if ( newDist < ent->distance )
+			{
+				ent->ent = testEnt;
+				ent->distance = newDist;
+			}
 		}
 	}
 }
@@ -526,22 +656,18 @@ void BotFindDamagedFriendlyStructure( gentity_t *self )
 {
 	float minDistSqr;
 
-	gentity_t *target;
 	self->botMind->closestDamagedBuilding.ent = nullptr;
 	self->botMind->closestDamagedBuilding.distance = INT_MAX;
 
 	minDistSqr = Square( self->botMind->closestDamagedBuilding.distance );
 
-	for ( target = &g_entities[MAX_CLIENTS]; target < &g_entities[level.num_entities - 1]; target++ )
+	BotUpdatePerception();
+
+	for ( gentity_t *target : perception.buildablesByTeam[ self->client->pers.team ] )
 	{
 		float distSqr;
 
-		if ( !target->inuse )
-		{
-			continue;
-		}
-
-		if ( target->s.eType != entityType_t::ET_BUILDABLE )
+		if ( !BotIsBuildable( target ) )
 		{
 			continue;
 		}
@@ -589,34 +715,33 @@ gentity_t* BotFindBestEnemy( gentity_t *self )
 	float bestInvisibleEnemyScore = 0;
 	gentity_t *bestVisibleEnemy = nullptr;
 	gentity_t *bestInvisibleEnemy = nullptr;
-	gentity_t *target;
 	team_t    team = BotGetEntityTeam( self );
 	bool  hasRadar = ( team == TEAM_ALIENS ) ||
 	                     ( team == TEAM_HUMANS && BG_InventoryContainsUpgrade( UP_RADAR, self->client->ps.stats ) );
 
-	for ( target = g_entities; target < &g_entities[level.num_entities - 1]; target++ )
+	BotForTargetsNear( self->s.origin, [&]( gentity_t *target )
 	{
 		float newScore;
 
 		if ( !BotEnemyIsValid( self, target ) )
 		{
-			continue;
+			return;
 		}
 
 		if ( DistanceSquared( self->s.origin, target->s.origin ) > Square( ALIENSENSE_RANGE ) )
 		{
-			continue;
+			return;
 		}
 
 		if ( target->s.eType == entityType_t::ET_PLAYER && self->client->pers.team == TEAM_HUMANS
 		    && BotAimAngle( self, target->s.origin ) > g_bot_fov.value / 2 )
 		{
-			continue;
+			return;
 		}
 
 		if ( target == self->botMind->goal.ent )
 		{
-			continue;
+			return;
 		}
 
 		newScore = BotGetEnemyPriority( self, target );
@@ -632,7 +757,8 @@ gentity_t* BotFindBestEnemy( gentity_t *self )
 			bestInvisibleEnemyScore = newScore;
 			bestInvisibleEnemy = target;
 		}
-	}
+	} );
+
 	if ( bestVisibleEnemy || !hasRadar )
 	{
 		return bestVisibleEnemy;
@@ -647,21 +773,20 @@ gentity_t* BotFindClosestEnemy( gentity_t *self )
 {
 	gentity_t* closestEnemy = nullptr;
 	float minDistance = Square( ALIENSENSE_RANGE );
-	gentity_t *target;
 
-	for ( target = g_entities; target < &g_entities[level.num_entities - 1]; target++ )
+	BotForTargetsNear( self->s.origin, [&]( gentity_t *target )
 	{
 		float newDistance;
 		//ignore entities that arnt in use
 		if ( !target->inuse )
 		{
-			continue;
+			return;
 		}
 
 		// Only consider living targets.
 		if ( !Entities::IsAlive( target ) )
 		{
-			continue;
+			return;
 		}
 
 		//ignore buildings if we cant attack them
@@ -669,26 +794,26 @@ gentity_t* BotFindClosestEnemy( gentity_t *self )
 		{
 			if ( !g_bot_attackStruct.integer )
 			{
-				continue;
+				return;
 			}
 
 			// dretches can only bite buildables in construction
 			if ( self->client->ps.stats[STAT_CLASS] == PCL_ALIEN_LEVEL0 && target->spawned )
 			{
-				continue;
+				return;
 			}
 		}
 
 		//ignore neutrals
 		if ( BotGetEntityTeam( target ) == TEAM_NONE )
 		{
-			continue;
+			return;
 		}
 
 		//ignore teamates
 		if ( BotGetEntityTeam( target ) == BotGetEntityTeam( self ) )
 		{
-			continue;
+			return;
 		}
 
 		//ignore spectators
@@ -696,7 +821,7 @@ gentity_t* BotFindClosestEnemy( gentity_t *self )
 		{
 			if ( target->client->sess.spectatorState != SPECTATOR_NOT )
 			{
-				continue;
+				return;
 			}
 		}
 		newDistance = DistanceSquared( self->s.origin, target->s.origin );
@@ -705,7 +830,8 @@ gentity_t* BotFindClosestEnemy( gentity_t *self )
 			minDistance = newDistance;
 			closestEnemy = target;
 		}
-	}
+	} );
+
 	return closestEnemy;
 }
 
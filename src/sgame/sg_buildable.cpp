@@ -319,14 +319,21 @@ void ABarricade_Touch( gentity_t *self, gentity_t *other, trace_t* )
 
 void ABooster_Think( gentity_t *self )
 {
-	gentity_t *ent;
+	gentity_t      *neighbors[ MAX_GENTITIES ];
+	int            numNeighbors;
+	entityFilter_t filter;
 	bool  playHealingEffect = false;
 
 	self->nextthink = level.time + BOOST_REPEAT_ANIM / 4;
 
 	// check if there is a closeby alien that used this booster for healing recently
-	for ( ent = nullptr; ( ent = G_IterateEntitiesWithinRadius( ent, self->s.origin, REGEN_BOOSTER_RANGE ) ); )
+	filter.team = TEAM_ALIENS;
+	numNeighbors = G_EntitiesWithinRadius( self->s.origin, REGEN_BOOSTER_RANGE, neighbors, MAX_GENTITIES, filter );
+
+	for ( int i = 0; i < numNeighbors; i++ )
 	{
+		gentity_t *ent = neighbors[ i ];
+
 		if ( ent->boosterUsed == self && ent->boosterTime == level.previousTime )
 		{
 			playHealingEffect = true;
@@ -928,11 +935,18 @@ void G_BuildableTouchTriggers( gentity_t *ent )
  */
 bool G_BuildableInRange( vec3_t origin, float radius, buildable_t buildable )
 {
-	gentity_t *neighbor = nullptr;
+	gentity_t      *neighbors[ MAX_GENTITIES ];
+	int            numNeighbors;
+	entityFilter_t filter;
 
-	while ( ( neighbor = G_IterateEntitiesWithinRadius( neighbor, origin, radius ) ) )
+	filter.eType = entityType_t::ET_BUILDABLE;
+	numNeighbors = G_EntitiesWithinRadius( origin, radius, neighbors, MAX_GENTITIES, filter );
+
+	for ( int i = 0; i < numNeighbors; i++ )
 	{
-		if ( neighbor->s.eType != entityType_t::ET_BUILDABLE || !neighbor->spawned || Entities::IsDead( neighbor ) ||
+		gentity_t *neighbor = neighbors[ i ];
+
+		if ( !neighbor->spawned || Entities::IsDead( neighbor ) ||
 		     ( neighbor->buildableTeam == TEAM_HUMANS && !neighbor->powered ) )
 		{
 			continue;
@@ -1783,12 +1783,7 @@ void ClientSpawn( gentity_t *ent, gentity_t *spawn, const vec3_t origin, const v
 
 	//clear the credits array
 	// TODO: Handle in HealthComponent or ClientComponent.
-	for ( i = 0; i < MAX_CLIENTS; i++ )
-	{
-		ent->credits[ i ].value = 0.0f;
-		ent->credits[ i ].time = 0;
-		ent->credits[ i ].team = TEAM_NONE;
-	}
+	G_ClearDamageCredits( ent );
 
 	G_SetOrigin( ent, spawn_origin );
 	VectorCopy( spawn_origin, client->ps.origin );
@@ -41,6 +41,12 @@ typedef struct worldEntity_s
 {
 	struct worldSector_s *worldSector;
 	struct worldEntity_s *nextEntityInWorldSector;
+
+	// loose grid broadphase
+	int                  gridLevel; // -1 = not linked in the grid
+	int                  gridCell;
+	struct worldEntity_s *prevEntityInCell;
+	struct worldEntity_s *nextEntityInCell;
 } worldEntity_t;
 
 worldEntity_t wentities[ MAX_GENTITIES ];
@@ -159,6 +165,51 @@ bool G_CM_inPVS( const vec3_t p1, const vec3_t p2 )
 	return true;
 }
 
+/*
+=================
+G_CM_PointCluster
+
+Returns the PVS cluster of a point, and stores its area in area if not null.
+The cluster is negative for points in solid or outside of the world.
+=================
+*/
+int G_CM_PointCluster( const vec3_t p, int *area )
+{
+	int leafnum = CM_PointLeafnum( p );
+
+	if ( area )
+	{
+		*area = CM_LeafArea( leafnum );
+	}
+
+	return CM_LeafCluster( leafnum );
+}
+
+int G_CM_NumClusters()
+{
+	return CM_NumClusters();
+}
+
+/*
+=================
+G_CM_ClusterInPVS
+
+The potentially visible set test of G_CM_inPVS for known clusters, which
+must not be negative.
+=================
+*/
+bool G_CM_ClusterInPVS( int fromCluster, int cluster )
+{
+	byte *mask = CM_ClusterPVS( fromCluster );
+
+	return !mask || ( mask[ cluster >> 3 ] & ( 1 << ( cluster & 7 ) ) );
+}
+
+bool G_CM_AreasConnected( int area1, int area2 )
+{
+	return CM_AreasConnected( area1, area2 );
+}
+
 /*
 =================
 G_CM_inPVSIgnorePortals
@@ -232,9 +283,20 @@ bool G_CM_EntityContact( const vec3_t mins, const vec3_t maxs, const gentity_t *
 ENTITY CHECKING
 
 To avoid linearly searching through lists of entities during environment testing,
-the world is carved up with an evenly spaced, axially aligned bsp tree.  Entities
-are kept in chains either at the final leafs, or at the first node that splits
-them, which prevents having to deal with multiple fragments of a single entity.
+entities are kept in a spatial structure. Two are available, selected with
+g_worldBroadphase:
+
+0: The world is carved up with an evenly spaced, axially aligned bsp tree.  Entities
+   are kept in chains either at the final leafs, or at the first node that splits
+   them, which prevents having to deal with multiple fragments of a single entity.
+   The tree is always 4 levels deep, so on large maps most entities end up in the
+   top nodes.
+
+1: A hierarchy of loose grids over the horizontal plane. Each entity is kept in the
+   single cell of the finest level whose cells are at least as wide as the
+   entity, using the cell that contains its center. Queries are expanded by half
+   a cell on each level to account for the looseness. The coarsest level is a
+   single cell that takes anything too big for the others.
 
 ===============================================================================
 */
@@ -254,6 +316,51 @@ typedef struct worldSector_s
 worldSector_t sv_worldSectors[ AREA_NODES ];
 int           sv_numworldSectors;
 
+#define GRID_MAX_LEVELS 8
+#define GRID_MIN_CELL   128
+#define GRID_MAX_CELL   1024
+#define GRID_AUTO_CELLS 64 // cells along the longest axis of level 0 when sized automatically
+
+struct gridLevel_t
+{
+	float                      cellSize;
+	int                        dims[ 2 ];
+	std::vector<worldEntity_t*> cells;
+};
+
+struct worldGrid_t
+{
+	vec2_t      origin;
+	int         numLevels;
+	gridLevel_t levels[ GRID_MAX_LEVELS ];
+};
+
+static worldGrid_t sv_worldGrid;
+
+enum class broadphase_t
+{
+	SECTOR_TREE,
+	LOOSE_GRID
+};
+
+static broadphase_t sv_broadphase = broadphase_t::LOOSE_GRID;
+
+static Cvar::Cvar<int> g_worldBroadphase(
+	"g_worldBroadphase", "entity broadphase: 0 - fixed sector tree, 1 - loose grid", Cvar::NONE, 1);
+static Cvar::Cvar<int> g_worldGridCellSize(
+	"g_worldGridCellSize", "size of the finest world grid cells, 0 to size from the map bounds; applied on map load", Cvar::NONE, 0);
+
+struct broadphaseStats_t
+{
+	int queries;     // area queries this frame
+	int visits;      // entities tested against a query box this frame
+	int lastQueries; // totals of the previous frame
+	int lastVisits;
+	int peakVisits;  // worst frame since the map was loaded
+};
+
+static broadphaseStats_t sv_broadphaseStats;
+
 /*
 ===============
 G_CM_SectorList_f
@@ -265,19 +372,57 @@ void G_CM_SectorList_f()
 	worldSector_t *sec;
 	worldEntity_t    *ent;
 
-	for ( i = 0; i < AREA_NODES; i++ )
+	if ( sv_broadphase == broadphase_t::SECTOR_TREE )
 	{
-		sec = &sv_worldSectors[ i ];
+		for ( i = 0; i < AREA_NODES; i++ )
+		{
+			sec = &sv_worldSectors[ i ];
 
-		c = 0;
+			c = 0;
 
-		for ( ent = sec->entities; ent; ent = ent->nextEntityInWorldSector )
-		{
-			c++;
+			for ( ent = sec->entities; ent; ent = ent->nextEntityInWorldSector )
+			{
+				c++;
+			}
+
+			Log::Notice( "sector %i: %i entities\n", i, c );
 		}
+	}
+	else
+	{
+		for ( i = 0; i < sv_worldGrid.numLevels; i++ )
+		{
+			gridLevel_t *level = &sv_worldGrid.levels[ i ];
+			int         occupied = 0, total = 0, most = 0;
 
-		Log::Notice( "sector %i: %i entities\n", i, c );
+			for ( worldEntity_t *cell : level->cells )
+			{
+				c = 0;
+
+				for ( ent = cell; ent; ent = ent->nextEntityInCell )
+				{
+					c++;
+				}
+
+				if ( c )
+				{
+					occupied++;
+					total += c;
+					most = std::max( most, c );
+				}
+			}
+
+			Log::Notice( "grid level %i: %g unit cells %ix%i, %i entities in %i cells, %.1f avg, %i max\n",
+			             i, level->cellSize, level->dims[ 0 ], level->dims[ 1 ], total, occupied,
+			             occupied ? ( float ) total / occupied : 0.0f, most );
+		}
 	}
+
+	Log::Notice( "last frame: %i queries, %i entity visits (%.1f per query), peak %i visits\n",
+	             sv_broadphaseStats.lastQueries, sv_broadphaseStats.lastVisits,
+	             sv_broadphaseStats.lastQueries ?
+	                 ( float ) sv_broadphaseStats.lastVisits / sv_broadphaseStats.lastQueries : 0.0f,
+	             sv_broadphaseStats.peakVisits );
 }
 
 /*
@@ -328,6 +473,51 @@ worldSector_t  *G_CM_CreateworldSector( int depth, vec3_t mins, vec3_t maxs )
 	return anode;
 }
 
+/*
+===============
+G_CM_CreateWorldGrid
+
+Builds the loose grid levels for the given world size. Cells double in size
+with every level, the last level being a single cell covering everything.
+===============
+*/
+static void G_CM_CreateWorldGrid( const vec3_t mins, const vec3_t maxs )
+{
+	float extent = std::max( maxs[ 0 ] - mins[ 0 ], maxs[ 1 ] - mins[ 1 ] );
+	float cellSize = g_worldGridCellSize.Get();
+
+	if ( cellSize <= 0 )
+	{
+		cellSize = Math::Clamp( extent / GRID_AUTO_CELLS, ( float ) GRID_MIN_CELL, ( float ) GRID_MAX_CELL );
+	}
+
+	sv_worldGrid.origin[ 0 ] = mins[ 0 ];
+	sv_worldGrid.origin[ 1 ] = mins[ 1 ];
+	sv_worldGrid.numLevels = 0;
+
+	while ( true )
+	{
+		gridLevel_t *level = &sv_worldGrid.levels[ sv_worldGrid.numLevels++ ];
+		bool        last = sv_worldGrid.numLevels == GRID_MAX_LEVELS || cellSize >= extent;
+
+		level->cellSize = last ? 0.0f : cellSize;
+
+		for ( int i = 0; i < 2; i++ )
+		{
+			level->dims[ i ] = last ? 1 : std::max( 1, ( int ) ceilf( ( maxs[ i ] - mins[ i ] ) / cellSize ) );
+		}
+
+		level->cells.assign( level->dims[ 0 ] * level->dims[ 1 ], nullptr );
+
+		if ( last )
+		{
+			break;
+		}
+
+		cellSize *= 2.0f;
+	}
+}
+
 /*
 ===============
 G_CM_ClearWorld
@@ -341,12 +531,107 @@ void G_CM_ClearWorld()
 
 	memset( sv_worldSectors, 0, sizeof( sv_worldSectors ) );
 	memset( wentities, 0, sizeof( wentities ) );
+	memset( &sv_broadphaseStats, 0, sizeof( sv_broadphaseStats ) );
 	sv_numworldSectors = 0;
 
+	for ( worldEntity_t &went : wentities )
+	{
+		went.gridLevel = -1;
+	}
+
+	sv_broadphase = g_worldBroadphase.Get() ? broadphase_t::LOOSE_GRID : broadphase_t::SECTOR_TREE;
+
 	// get world map bounds
 	h = CM_InlineModel( 0 );
 	CM_ModelBounds( h, mins, maxs );
 	G_CM_CreateworldSector( 0, mins, maxs );
+	G_CM_CreateWorldGrid( mins, maxs );
+}
+
+/*
+===============
+G_CM_GridCoord
+
+Returns the cell coordinate of a point along an axis, clamped to the grid.
+===============
+*/
+static int G_CM_GridCoord( const gridLevel_t *level, int axis, float point )
+{
+	if ( level->dims[ axis ] == 1 )
+	{
+		return 0;
+	}
+
+	int coord = ( int ) floorf( ( point - sv_worldGrid.origin[ axis ] ) / level->cellSize );
+
+	return Math::Clamp( coord, 0, level->dims[ axis ] - 1 );
+}
+
+/*
+===============
+G_CM_GridUnlink
+===============
+*/
+static void G_CM_GridUnlink( worldEntity_t *went )
+{
+	gridLevel_t *level = &sv_worldGrid.levels[ went->gridLevel ];
+
+	if ( went->prevEntityInCell )
+	{
+		went->prevEntityInCell->nextEntityInCell = went->nextEntityInCell;
+	}
+	else
+	{
+		level->cells[ went->gridCell ] = went->nextEntityInCell;
+	}
+
+	if ( went->nextEntityInCell )
+	{
+		went->nextEntityInCell->prevEntityInCell = went->prevEntityInCell;
+	}
+
+	went->gridLevel = -1;
+	went->prevEntityInCell = went->nextEntityInCell = nullptr;
+}
+
+/*
+===============
+G_CM_GridLink
+
+Puts the entity in the finest level that can hold its absolute box.
+===============
+*/
+static void G_CM_GridLink( worldEntity_t *went, const gentity_t *gEnt )
+{
+	float       size = std::max( gEnt->r.absmax[ 0 ] - gEnt->r.absmin[ 0 ],
+	                             gEnt->r.absmax[ 1 ] - gEnt->r.absmin[ 1 ] );
+	int         levelNum;
+	gridLevel_t *level;
+
+	for ( levelNum = 0; levelNum < sv_worldGrid.numLevels - 1; levelNum++ )
+	{
+		if ( size <= sv_worldGrid.levels[ levelNum ].cellSize )
+		{
+			break;
+		}
+	}
+
+	level = &sv_worldGrid.levels[ levelNum ];
+
+	int x = G_CM_GridCoord( level, 0, 0.5f * ( gEnt->r.absmin[ 0 ] + gEnt->r.absmax[ 0 ] ) );
+	int y = G_CM_GridCoord( level, 1, 0.5f * ( gEnt->r.absmin[ 1 ] + gEnt->r.absmax[ 1 ] ) );
+
+	went->gridLevel = levelNum;
+	went->gridCell = y * level->dims[ 0 ] + x;
+	went->prevEntityInCell = nullptr;
+	went->nextEntityInCell = level->cells[ went->gridCell ];
+
+	if ( went->nextEntityInCell )
+	{
+		went->nextEntityInCell->prevEntityInCell = went;
+	}
+
+	level->cells[ went->gridCell ] = went;
 }
 
 /*
@@ -364,6 +649,12 @@ void G_CM_UnlinkEntity( gentity_t *gEnt )
 
 	gEnt->r.linked = false;
 
+	if ( went->gridLevel != -1 )
+	{
+		G_CM_GridUnlink( went );
+		return;
+	}
+
 	ws = went->worldSector;
 
 	if ( !ws )
@@ -411,7 +702,7 @@ void G_CM_LinkEntity( gentity_t *gEnt )
 
 	worldEntity_t* went = G_CM_WorldEntityForGentity( gEnt );
 
-	if ( went->worldSector )
+	if ( went->worldSector || went->gridLevel != -1 )
 	{
 		G_CM_UnlinkEntity( gEnt );  // unlink from old position
 	}
@@ -568,6 +859,13 @@ void G_CM_LinkEntity( gentity_t *gEnt )
 
 	gEnt->r.linkcount++;
 
+	if ( sv_broadphase == broadphase_t::LOOSE_GRID )
+	{
+		G_CM_GridLink( went, gEnt );
+		gEnt->r.linked = true;
+		return;
+	}
+
 	// find the first world sector node that the ent's box crosses
 	node = sv_worldSectors;
 
@@ -637,6 +935,7 @@ void G_CM_AreaEntities_r( worldSector_t *node, areaParms_t *ap )
 		next = check->nextEntityInWorldSector;
 
 		gcheck = G_CM_GEntityForWorldEntity( check );
+		sv_broadphaseStats.visits++;
 
 		if ( !gcheck->r.linked )
 		{
@@ -678,6 +977,55 @@ void G_CM_AreaEntities_r( worldSector_t *node, areaParms_t *ap )
 	}
 }
 
+/*
+====================
+G_CM_AreaEntitiesGrid
+
+====================
+*/
+static void G_CM_AreaEntitiesGrid( areaParms_t *ap )
+{
+	for ( int levelNum = 0; levelNum < sv_worldGrid.numLevels; levelNum++ )
+	{
+		const gridLevel_t *level = &sv_worldGrid.levels[ levelNum ];
+		float             loose = 0.5f * level->cellSize;
+
+		int x0 = G_CM_GridCoord( level, 0, ap->mins[ 0 ] - loose );
+		int x1 = G_CM_GridCoord( level, 0, ap->maxs[ 0 ] + loose );
+		int y0 = G_CM_GridCoord( level, 1, ap->mins[ 1 ] - loose );
+		int y1 = G_CM_GridCoord( level, 1, ap->maxs[ 1 ] + loose );
+
+		for ( int y = y0; y <= y1; y++ )
+		{
+			for ( int x = x0; x <= x1; x++ )
+			{
+				for ( worldEntity_t *check = level->cells[ y * level->dims[ 0 ] + x ]; check; check = check->nextEntityInCell )
+				{
+					gentity_t *gcheck = G_CM_GEntityForWorldEntity( check );
+					sv_broadphaseStats.visits++;
+
+					if ( gcheck->r.absmin[ 0 ] > ap->maxs[ 0 ]
+					     || gcheck->r.absmin[ 1 ] > ap->maxs[ 1 ]
+					     || gcheck->r.absmin[ 2 ] > ap->maxs[ 2 ]
+					     || gcheck->r.absmax[ 0 ] < ap->mins[ 0 ] || gcheck->r.absmax[ 1 ] < ap->mins[ 1 ] || gcheck->r.absmax[ 2 ] < ap->mins[ 2 ] )
+					{
+						continue;
+					}
+
+					if ( ap->count == ap->maxcount )
+					{
+						Log::Notice( "G_CM_AreaEntities: MAXCOUNT\n" );
+						return;
+					}
+
+					ap->list[ ap->count ] = check - wentities;
+					ap->count++;
+				}
+			}
+		}
+	}
+}
+
 /*
 ================
 G_CM_AreaEntities
@@ -693,11 +1041,74 @@ int G_CM_AreaEntities( const vec3_t mins, const vec3_t maxs, int *entityList, in
 	ap.count = 0;
 	ap.maxcount = maxcount;
 
-	G_CM_AreaEntities_r( sv_worldSectors, &ap );
+	sv_broadphaseStats.queries++;
+
+	if ( sv_broadphase == broadphase_t::LOOSE_GRID )
+	{
+		G_CM_AreaEntitiesGrid( &ap );
+	}
+	else
+	{
+		G_CM_AreaEntities_r( sv_worldSectors, &ap );
+	}
 
 	return ap.count;
 }
 
+/*
+================
+G_CM_SetBroadphase
+
+Moves every linked entity over to the requested structure.
+================
+*/
+static void G_CM_SetBroadphase( broadphase_t broadphase )
+{
+	std::vector<gentity_t*> relink;
+
+	for ( int i = 0; i < MAX_GENTITIES; i++ )
+	{
+		if ( wentities[ i ].worldSector || wentities[ i ].gridLevel != -1 )
+		{
+			relink.push_back( &g_entities[ i ] );
+			G_CM_UnlinkEntity( &g_entities[ i ] );
+		}
+	}
+
+	sv_broadphase = broadphase;
+
+	for ( gentity_t *ent : relink )
+	{
+		G_CM_LinkEntity( ent );
+	}
+
+	Log::Notice( "switched entity broadphase to %s, relinked %i entities\n",
+	             broadphase == broadphase_t::LOOSE_GRID ? "loose grid" : "sector tree", (int) relink.size() );
+}
+
+/*
+================
+G_CM_EndFrame
+
+Rolls over the per-frame query statistics and applies broadphase changes.
+================
+*/
+void G_CM_EndFrame()
+{
+	broadphase_t wanted = g_worldBroadphase.Get() ? broadphase_t::LOOSE_GRID : broadphase_t::SECTOR_TREE;
+
+	if ( wanted != sv_broadphase )
+	{
+		G_CM_SetBroadphase( wanted );
+	}
+
+	sv_broadphaseStats.lastQueries = sv_broadphaseStats.queries;
+	sv_broadphaseStats.lastVisits = sv_broadphaseStats.visits;
+	sv_broadphaseStats.peakVisits = std::max( sv_broadphaseStats.peakVisits, sv_broadphaseStats.visits );
+	sv_broadphaseStats.queries = 0;
+	sv_broadphaseStats.visits = 0;
+}
+
 //===========================================================================
 
 struct moveclip_t
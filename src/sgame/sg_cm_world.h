@@ -60,6 +60,13 @@ clipHandle_t G_CM_ClipHandleForEntity( const sharedEntity_t *ent );
 
 void         G_CM_SectorList_f();
 
+// prints the broadphase occupancy and query statistics
+
+void         G_CM_EndFrame();
+
+// called once per server frame to roll over the query statistics
+// and to switch broadphase when g_worldBroadphase changes
+
 int          G_CM_AreaEntities( const vec3_t mins, const vec3_t maxs, int *entityList, int maxcount );
 
 // fills in a table of entity numbers with entities that have bounding boxes
@@ -93,6 +100,12 @@ bool G_CM_inPVS( const vec3_t p1, const vec3_t p2 );
 
 bool G_CM_inPVSIgnorePortals( const vec3_t p1, const vec3_t p2 );
 
+// for precomputing PVS tests between fixed points
+int  G_CM_PointCluster( const vec3_t p, int *area );
+int  G_CM_NumClusters();
+bool G_CM_ClusterInPVS( int fromCluster, int cluster );
+bool G_CM_AreasConnected( int area1, int area2 );
+
 void G_CM_AdjustAreaPortalState( gentity_t *ent, bool open );
 
 bool G_CM_EntityContact( const vec3_t mins, const vec3_t maxs, const gentity_t *gEnt, traceType_t type );
@@ -329,27 +329,55 @@ int G_ClientNumbersFromString( const char *s, int *plist, int max )
 	return found;
 }
 
+/*
+ * A line of the scoreboard as seen by a given client.
+ */
+enum scoreField_t
+{
+	SCORE_SCORE,
+	SCORE_PING,
+	SCORE_TIME,
+	SCORE_WEAPON,
+	SCORE_UPGRADE,
+
+	NUM_SCORE_FIELDS
+};
+
+struct scoreRow_t
+{
+	int client;
+	int fields[ NUM_SCORE_FIELDS ];
+};
+
+/*
+ * The scoreboard last sent to every client, further updates only carry the
+ * difference to it.
+ */
+struct scoreboardSent_t
+{
+	bool       valid;
+	int        enterTime; // the client reconnected if this doesn't match anymore
+	int        numRows;
+	scoreRow_t rows[ MAX_CLIENTS ];
+};
+
+static scoreboardSent_t scoreboardSent[ MAX_CLIENTS ];
+
 /*
 ==================
-ScoreboardMessage
+G_ScoreboardRows
 
+Fills in the scoreboard as seen by ent, in the order of level.sortedClients
 ==================
 */
-void ScoreboardMessage( gentity_t *ent )
+static int G_ScoreboardRows( gentity_t *ent, scoreRow_t *rows )
 {
-	char      entry[ 1024 ];
-	char      string[ 1400 ];
-	int       stringlength;
-	int       i, j;
+	int       i;
 	gclient_t *cl;
 	int       numSorted;
 	weapon_t  weapon = WP_NONE;
 	upgrade_t upgrade = UP_NONE;
 
-	// send the latest information on all clients
-	string[ 0 ] = 0;
-	stringlength = 0;
-
 	numSorted = level.numConnectedClients;
 
 	for ( i = 0; i < numSorted; i++ )
@@ -404,9 +432,140 @@ void ScoreboardMessage( gentity_t *ent )
 			upgrade = UP_NONE;
 		}
 
+		rows[ i ].client = level.sortedClients[ i ];
+		rows[ i ].fields[ SCORE_SCORE ] = cl->ps.persistant[ PERS_SCORE ];
+		rows[ i ].fields[ SCORE_PING ] = ping;
+		rows[ i ].fields[ SCORE_TIME ] = ( level.time - cl->pers.enterTime ) / 60000;
+		rows[ i ].fields[ SCORE_WEAPON ] = weapon;
+		rows[ i ].fields[ SCORE_UPGRADE ] = upgrade;
+	}
+
+	return numSorted;
+}
+
+/*
+==================
+G_ScoreboardDelta
+
+Writes the changes from the scoreboard sent last to string.
+
+Format:
+  order, - if it didn't change or o followed by the client numbers in two hex
+  digits each, then for every client whose line changed
+  clientNum fieldMask and the value of every field set in the mask
+
+Returns false if it doesn't fit.
+==================
+*/
+static bool G_ScoreboardDelta( const scoreboardSent_t *sent, const scoreRow_t *rows, int numRows,
+                               char *string, int size )
+{
+	int  i, j;
+	int  previous[ MAX_CLIENTS ];
+	bool reordered = ( numRows != sent->numRows );
+	int  length;
+
+	for ( i = 0; i < MAX_CLIENTS; i++ )
+	{
+		previous[ i ] = -1;
+	}
+
+	for ( i = 0; i < sent->numRows; i++ )
+	{
+		previous[ sent->rows[ i ].client ] = i;
+	}
+
+	for ( i = 0; i < numRows && !reordered; i++ )
+	{
+		reordered = ( rows[ i ].client != sent->rows[ i ].client );
+	}
+
+	if ( !reordered )
+	{
+		length = Com_sprintf( string, size, " -" );
+	}
+	else
+	{
+		length = Com_sprintf( string, size, " o" );
+
+		for ( i = 0; i < numRows && length < size - 1; i++ )
+		{
+			length += Com_sprintf( string + length, size - length, "%02x", rows[ i ].client );
+		}
+	}
+
+	for ( i = 0; i < numRows && length < size - 1; i++ )
+	{
+		int prev = previous[ rows[ i ].client ];
+		int mask = 0;
+
+		for ( j = 0; j < NUM_SCORE_FIELDS; j++ )
+		{
+			if ( prev < 0 || sent->rows[ prev ].fields[ j ] != rows[ i ].fields[ j ] )
+			{
+				mask |= 1 << j;
+			}
+		}
+
+		if ( !mask )
+		{
+			continue;
+		}
+
+		length += Com_sprintf( string + length, size - length, " %d %d", rows[ i ].client, mask );
+
+		for ( j = 0; j < NUM_SCORE_FIELDS && length < size - 1; j++ )
+		{
+			if ( mask & ( 1 << j ) )
+			{
+				length += Com_sprintf( string + length, size - length, " %d", rows[ i ].fields[ j ] );
+			}
+		}
+	}
+
+	return length < size - 1;
+}
+
+/*
+==================
+ScoreboardMessage
+
+Sends the whole scoreboard the first time, and only what changed since then
+==================
+*/
+void ScoreboardMessage( gentity_t *ent )
+{
+	char             entry[ 1024 ];
+	char             string[ 1400 ];
+	int              stringlength;
+	int              i, j;
+	scoreRow_t       rows[ MAX_CLIENTS ];
+	int              numRows;
+	scoreboardSent_t *sent = &scoreboardSent[ ent - g_entities ];
+
+	numRows = G_ScoreboardRows( ent, rows );
+
+	if ( sent->valid && sent->enterTime == ent->client->pers.enterTime &&
+	     G_ScoreboardDelta( sent, rows, numRows, string, sizeof( string ) ) )
+	{
+		trap_SendServerCommand( ent - g_entities, va( "scored %i %i%s",
+		                        level.team[ TEAM_ALIENS ].kills, level.team[ TEAM_HUMANS ].kills, string ) );
+
+		sent->numRows = numRows;
+		memcpy( sent->rows, rows, numRows * sizeof( rows[ 0 ] ) );
+		return;
+	}
+
+	// send the latest information on all clients
+	string[ 0 ] = 0;
+	stringlength = 0;
+
+	for ( i = 0; i < numRows; i++ )
+	{
 		Com_sprintf( entry, sizeof( entry ),
-		             " %d %d %d %d %d %d", level.sortedClients[ i ], cl->ps.persistant[ PERS_SCORE ],
-		             ping, ( level.time - cl->pers.enterTime ) / 60000, weapon, upgrade );
+		             " %d %d %d %d %d %d", rows[ i ].client, rows[ i ].fields[ SCORE_SCORE ],
+		             rows[ i ].fields[ SCORE_PING ], rows[ i ].fields[ SCORE_TIME ],
+		             rows[ i ].fields[ SCORE_WEAPON ], rows[ i ].fields[ SCORE_UPGRADE ] );
 
 		j = strlen( entry );
 
@@ -421,6 +580,37 @@ void ScoreboardMessage( gentity_t *ent )
 
 	trap_SendServerCommand( ent - g_entities, va( "scores %i %i%s",
 	                        level.team[ TEAM_ALIENS ].kills, level.team[ TEAM_HUMANS ].kills, string ) );
+
+	// what didn't fit isn't known to the client
+	sent->valid = true;
+	sent->enterTime = ent->client->pers.enterTime;
+	sent->numRows = i;
+	memcpy( sent->rows, rows, i * sizeof( rows[ 0 ] ) );
+}
+
+/*
+==================
+Cmd_Score_f
+
+score [full]
+==================
+*/
+static void Cmd_Score_f( gentity_t *ent )
+{
+	char arg[ 8 ];
+
+	// the client lost what it was sent so far
+	if ( trap_Argc() > 1 )
+	{
+		trap_Argv( 1, arg, sizeof( arg ) );
+
+		if ( !Q_stricmp( arg, "full" ) )
+		{
+			scoreboardSent[ ent - g_entities ].valid = false;
+		}
+	}
+
+	ScoreboardMessage( ent );
 }
 
 /*
@@ -4391,7 +4581,7 @@ static const commands_t cmds[] =
 	{ "say_area",        CMD_MESSAGE | CMD_TEAM | CMD_ALIVE,  Cmd_SayArea_f          },
 	{ "say_area_team",   CMD_MESSAGE | CMD_TEAM | CMD_ALIVE,  Cmd_SayAreaTeam_f      },
 	{ "say_team",        CMD_MESSAGE | CMD_INTERMISSION,      Cmd_Say_f              },
-	{ "score",           CMD_INTERMISSION,                    ScoreboardMessage      },
+	{ "score",           CMD_INTERMISSION,                    Cmd_Score_f            },
 	{ "sell",            CMD_HUMAN | CMD_ALIVE,               Cmd_Sell_f             },
 	{ "setviewpos",      CMD_CHEAT_TEAM,                      Cmd_SetViewpos_f       },
 	{ "team",            0,                                   Cmd_Team_f             },
@@ -145,17 +145,88 @@ void LookAtKiller( gentity_t *self, gentity_t *inflictor, gentity_t *attacker )
 	}
 }
 
+/**
+ * @brief Returns the credit of a client in the damage ledger of an entity, nullptr if it has none.
+ * @param ledger
+ * @param clientNum
+ */
+static damageCredit_t *G_FindDamageCredit( damageLedger_t &ledger, int clientNum )
+{
+	for ( int i = 0; i < ledger.numCredits; i++ )
+	{
+		if ( ledger[ i ].clientNum == clientNum )
+		{
+			return &ledger[ i ];
+		}
+	}
+
+	return nullptr;
+}
+
+/**
+ * @brief Adds damage dealt by a client to its credit on an entity.
+ * @param self
+ * @param clientNum
+ * @param damage
+ * @param team the team of the client when it dealt the damage
+ */
+void G_AddDamageCredit( gentity_t *self, int clientNum, float damage, team_t team )
+{
+	damageLedger_t &ledger = self->damageLedger;
+	damageCredit_t *credit = G_FindDamageCredit( ledger, clientNum );
+
+	if ( !credit )
+	{
+		// grow the overflow storage when the inline credits and it are full
+		if ( ledger.numCredits == DAMAGE_LEDGER_INLINE + ledger.extraSize )
+		{
+			int            extraSize = std::max( DAMAGE_LEDGER_INLINE, 2 * ledger.extraSize );
+			damageCredit_t *extra = ( damageCredit_t * ) BG_Alloc( extraSize * sizeof( damageCredit_t ) );
+
+			if ( ledger.extra )
+			{
+				memcpy( extra, ledger.extra, ledger.extraSize * sizeof( damageCredit_t ) );
+				BG_Free( ledger.extra );
+			}
+
+			ledger.extra = extra;
+			ledger.extraSize = extraSize;
+		}
+
+		credit = &ledger[ ledger.numCredits++ ];
+		credit->clientNum = clientNum;
+		credit->value = 0.0f;
+	}
+
+	credit->value += damage;
+	credit->time = level.time;
+	credit->team = team;
+}
+
+/**
+ * @brief Forgets the damage all clients dealt to an entity.
+ * @param self
+ */
+void G_ClearDamageCredits( gentity_t *self )
+{
+	if ( self->damageLedger.extra )
+	{
+		BG_Free( self->damageLedger.extra );
+	}
+
+	memset( &self->damageLedger, 0, sizeof( self->damageLedger ) );
+}
+
 /**
  * @brief Function to find who assisted most (and, in case of a tie, most recently) with a kill
  * @param self
  * @param killer
  */
-static const gentity_t *G_FindKillAssist( const gentity_t *self, const gentity_t *killer, team_t *team )
+static const gentity_t *G_FindKillAssist( gentity_t *self, const gentity_t *killer, team_t *team )
 {
 	const gentity_t *assistant = nullptr;
 	float           damage;
 	int             when = 0;
-	int             playerNum;
 
 	// Suicide? No assistance needed with that
 	if ( killer == self)
@@ -163,30 +234,38 @@ static const gentity_t *G_FindKillAssist( const gentity_t *self, const gentity_t
 		return nullptr;
 	}
 
+	damageLedger_t &ledger = self->damageLedger;
+
 	// Require that the assist was for, at least, 25% of the damage or
 	// as much damage as the killer did, whichever is lower
 	damage = self->entity->Get<HealthComponent>()->MaxHealth() / 4.0f;
-	if ( killer )
+	if ( killer && killer->client )
 	{
-		damage = std::min( damage, self->credits[ killer - g_entities ].value );
+		const damageCredit_t *killerCredit = G_FindDamageCredit( ledger, killer - g_entities );
+
+		damage = std::min( damage, killerCredit ? killerCredit->value : 0.0f );
 	}
 
-	for ( playerNum = 0; playerNum < level.maxclients; ++playerNum )
+	for ( int i = 0; i < ledger.numCredits; i++ )
 	{
-		const gentity_t *player = &g_entities[ playerNum ];
+		const damageCredit_t &credit = ledger[ i ];
+		const gentity_t      *player = &g_entities[ credit.clientNum ];
 
-		if ( player == killer || player == self || self->credits[ playerNum ].team <= TEAM_NONE )
+		if ( player == killer || player == self || credit.team <= TEAM_NONE )
 		{
 			continue;
 		}
 
-		if ( self->credits[ playerNum ].value > damage ||
-		     (self->credits[ playerNum ].value == damage && self->credits[ playerNum ].time > when ) )
+		// credits aren't ordered by client number, break complete ties in favour
+		// of the lower one like a scan over all clients would
+		if ( credit.value > damage ||
+		     ( credit.value == damage && ( credit.time > when ||
+		       ( credit.time == when && assistant && player < assistant ) ) ) )
 		{
 			assistant = player;
-			damage = self->credits[ playerNum ].value;
-			when = self->credits[ playerNum ].time;
-			*team = self->credits[ playerNum ].team;
+			damage = credit.value;
+			when = credit.time;
+			*team = credit.team;
 		}
 	}
 
@@ -200,7 +279,7 @@ static const gentity_t *G_FindKillAssist( const gentity_t *self, const gentity_t
 void G_RewardAttackers( gentity_t *self )
 {
 	float     value, share, reward, enemyDamage, damageShare;
-	int       playerNum, maxHealth;
+	int       i, maxHealth;
 	gentity_t *player;
 	team_t    ownTeam, playerTeam;
 
@@ -241,12 +320,14 @@ void G_RewardAttackers( gentity_t *self )
 		return;
 	}
 
+	damageLedger_t &ledger = self->damageLedger;
+
 	// Sum up damage dealt by enemies
 	enemyDamage = 0.0f;
 
-	for ( playerNum = 0; playerNum < level.maxclients; playerNum++ )
+	for ( i = 0; i < ledger.numCredits; i++ )
 	{
-		player     = &g_entities[ playerNum ];
+		player     = &g_entities[ ledger[ i ].clientNum ];
 		playerTeam = (team_t) player->client->pers.team;
 
 		// Player must be on the other team
@@ -255,7 +336,7 @@ void G_RewardAttackers( gentity_t *self )
 			continue;
 		}
 
-		enemyDamage += self->credits[ playerNum ].value;
+		enemyDamage += ledger[ i ].value;
 	}
 
 	if ( enemyDamage <= 0 )
@@ -264,14 +345,14 @@ void G_RewardAttackers( gentity_t *self )
 	}
 
 	// Give individual rewards
-	for ( playerNum = 0; playerNum < level.maxclients; playerNum++ )
+	for ( i = 0; i < ledger.numCredits; i++ )
 	{
-		player      = &g_entities[ playerNum ];
+		player      = &g_entities[ ledger[ i ].clientNum ];
 		playerTeam  = (team_t) player->client->pers.team;
-		damageShare = self->credits[ playerNum ].value;
+		damageShare = ledger[ i ].value;
 
 		// Clear reward array
-		self->credits[ playerNum ].value = 0.0f;
+		ledger[ i ].value = 0.0f;
 
 		// Player must be on the other team
 		if ( playerTeam == ownTeam || playerTeam <= TEAM_NONE || playerTeam >= NUM_TEAMS )
@@ -790,13 +871,26 @@ void G_SelectiveDamage( gentity_t *targ, gentity_t *inflictor, gentity_t *attack
 	}
 }
 
+// offsets of the points of a target that are tested for visibility, the first
+// one is the midpoint of its bounds
+// this should probably check in the plane of projection,
+// rather than in world coordinate, and also include Z
+static const float canDamageOffsets[][ 2 ] =
+{
+	{   0.0f,   0.0f },
+	{  15.0f,  15.0f },
+	{  15.0f, -15.0f },
+	{ -15.0f,  15.0f },
+	{ -15.0f, -15.0f },
+};
+
+#define NUM_CANDAMAGE_TRACES ARRAY_LEN( canDamageOffsets )
+
 /**
- * @brief Used for explosions and melee attacks.
- * @param targ
- * @param origin
- * @return true if the inflictor can directly damage the target.
+ * @brief Does the traces of G_CanDamage.
+ * @param numTraces incremented by the number of traces done
  */
-bool G_CanDamage( gentity_t *targ, vec3_t origin )
+static bool G_CanDamageTraces( gentity_t *targ, const vec3_t origin, int *numTraces )
 {
 	vec3_t  dest;
 	trace_t tr;
@@ -807,128 +901,233 @@ bool G_CanDamage( gentity_t *targ, vec3_t origin )
 	VectorAdd( targ->r.absmin, targ->r.absmax, midpoint );
 	VectorScale( midpoint, 0.5, midpoint );
 
-	VectorCopy( midpoint, dest );
-	trap_Trace( &tr, origin, vec3_origin, vec3_origin, dest, ENTITYNUM_NONE, MASK_SOLID, 0 );
-
-	if ( tr.fraction == 1.0  || tr.entityNum == targ->s.number )
+	for ( unsigned i = 0; i < NUM_CANDAMAGE_TRACES; i++ )
 	{
-		return true;
+		VectorCopy( midpoint, dest );
+		dest[ 0 ] += canDamageOffsets[ i ][ 0 ];
+		dest[ 1 ] += canDamageOffsets[ i ][ 1 ];
+		trap_Trace( &tr, origin, vec3_origin, vec3_origin, dest, ENTITYNUM_NONE, MASK_SOLID, 0 );
+		( *numTraces )++;
+
+		// only the trace to the midpoint may stop on the target itself
+		if ( tr.fraction == 1.0f || ( i == 0 && tr.entityNum == targ->s.number ) )
+		{
+			return true;
+		}
 	}
 
-	// this should probably check in the plane of projection,
-	// rather than in world coordinate, and also include Z
-	VectorCopy( midpoint, dest );
-	dest[ 0 ] += 15.0;
-	dest[ 1 ] += 15.0;
-	trap_Trace( &tr, origin, vec3_origin, vec3_origin, dest, ENTITYNUM_NONE, MASK_SOLID, 0 );
+	return false;
+}
 
-	if ( tr.fraction == 1.0 )
-	{
-		return true;
-	}
+/**
+ * @brief Used for explosions and melee attacks.
+ * @param targ
+ * @param origin
+ * @return true if the inflictor can directly damage the target.
+ */
+bool G_CanDamage( gentity_t *targ, vec3_t origin )
+{
+	int numTraces = 0;
 
-	VectorCopy( midpoint, dest );
-	dest[ 0 ] += 15.0;
-	dest[ 1 ] -= 15.0;
-	trap_Trace( &tr, origin, vec3_origin, vec3_origin, dest, ENTITYNUM_NONE, MASK_SOLID, 0 );
+	return G_CanDamageTraces( targ, origin, &numTraces );
+}
 
-	if ( tr.fraction == 1.0 )
-	{
-		return true;
-	}
+/*
+=================================================================================
 
-	VectorCopy( midpoint, dest );
-	dest[ 0 ] -= 15.0;
-	dest[ 1 ] += 15.0;
-	trap_Trace( &tr, origin, vec3_origin, vec3_origin, dest, ENTITYNUM_NONE, MASK_SOLID, 0 );
+splash damage
 
-	if ( tr.fraction == 1.0 )
-	{
-		return true;
-	}
+The entities in the radius are gathered and culled by distance and by whether the
+explosion could affect them at all before any trace is done, so only the entities
+that could actually take damage pay for the visibility traces.
 
-	VectorCopy( midpoint, dest );
-	dest[ 0 ] -= 15.0;
-	dest[ 1 ] -= 15.0;
-	trap_Trace( &tr, origin, vec3_origin, vec3_origin, dest, ENTITYNUM_NONE, MASK_SOLID, 0 );
+=================================================================================
+*/
 
-	if ( tr.fraction == 1.0 )
-	{
-		return true;
-	}
+struct splashCandidate_t
+{
+	GentityRef ent;  // an earlier victim may have removed it
+	float      dist; // from the edge of the bounding box
+};
 
-	return false;
-}
+// damaging an entity can set off another explosion, so this must not be shared
+struct splashDamage_t
+{
+	std::vector<splashCandidate_t> candidates;
+	int                            numTraces = 0;
+	int                            numCached = 0;
+};
 
-bool G_SelectiveRadiusDamage( vec3_t origin, gentity_t *attacker, float damage,
-                                  float radius, gentity_t *ignore, int mod, int ignoreTeam )
+// visibility already traced this frame from an explosion origin to an entity
+struct splashVisibility_t
 {
-	float     points, dist;
-	gentity_t *ent;
-	int       entityList[ MAX_GENTITIES ];
-	int       numListedEntities;
-	vec3_t    mins, maxs;
-	int       i, e;
-	bool  hitClient = false;
+	vec3_t   origin;
+	int      entityNum;
+	unsigned generation;
+	vec3_t   absmin, absmax; // the traces aim at these, so a move is a miss
+	bool     visible;
+};
 
-	if ( radius < 1 )
+// several splashes often come from the same point in a frame (a missile's
+// impact and a turret's safety test of it, repeated fire at one spot), so
+// their traces are kept for the rest of the frame; a target that moved
+// misses, a mover that moved in front of it since is not noticed
+static std::unordered_map<uint32_t, splashVisibility_t> splashVisibility;
+static int splashVisibilityTime = -1;
+
+static uint32_t G_SplashVisibilityHash( const vec3_t origin, int entityNum )
+{
+	uint32_t hash = 2166136261u;
+	uint32_t words[ 4 ];
+
+	memcpy( words, origin, sizeof( vec3_t ) );
+	words[ 3 ] = entityNum;
+
+	for ( uint32_t word : words )
 	{
-		radius = 1;
+		hash = ( hash ^ word ) * 16777619u;
 	}
 
-	for ( i = 0; i < 3; i++ )
+	return hash;
+}
+
+/**
+ * @brief Lists the entities within radius that pass the filter.
+ */
+template<typename Filter>
+static void G_SplashGather( splashDamage_t &splash, const vec3_t origin, float radius,
+                            gentity_t *ignore, Filter filter )
+{
+	int    entityList[ MAX_GENTITIES ];
+	vec3_t mins, maxs;
+
+	for ( int i = 0; i < 3; i++ )
 	{
 		mins[ i ] = origin[ i ] - radius;
 		maxs[ i ] = origin[ i ] + radius;
 	}
 
-	numListedEntities = trap_EntitiesInBox( mins, maxs, entityList, MAX_GENTITIES );
+	int numListedEntities = trap_EntitiesInBox( mins, maxs, entityList, MAX_GENTITIES );
 
-	for ( e = 0; e < numListedEntities; e++ )
+	splash.candidates.reserve( numListedEntities );
+
+	for ( int e = 0; e < numListedEntities; e++ )
 	{
-		ent = &g_entities[ entityList[ e ] ];
+		gentity_t *ent = &g_entities[ entityList[ e ] ];
 
 		if ( ent == ignore )
 		{
 			continue;
 		}
 
-		if ( ent->flags & FL_NOTARGET )
+		// entities without health can't take damage
+		if ( !ent->entity->Get<HealthComponent>() )
 		{
 			continue;
 		}
 
 		// find the distance from the edge of the bounding box
-		dist = G_DistanceToBBox( origin, ent );
+		float dist = G_DistanceToBBox( origin, ent );
 
-		if ( dist >= radius )
+		if ( dist >= radius || !filter( ent ) )
 		{
 			continue;
 		}
 
-		points = damage * ( 1.0 - dist / radius );
+		splashCandidate_t candidate;
+		candidate.ent = ent;
+		candidate.dist = dist;
+		splash.candidates.push_back( candidate );
+	}
+}
+
+/**
+ * @brief Whether a gathered candidate is still there and exposed to the explosion.
+ */
+static bool G_SplashVisible( splashDamage_t &splash, splashCandidate_t &candidate, const vec3_t origin )
+{
+	if ( !candidate.ent )
+	{
+		return false;
+	}
+
+	gentity_t *ent = candidate.ent.entity;
 
-		if ( G_CanDamage( ent, origin ) && ent->client &&
-		     ent->client->pers.team != ignoreTeam )
+	if ( splashVisibilityTime != level.time )
+	{
+		splashVisibility.clear();
+		splashVisibilityTime = level.time;
+	}
+
+	splashVisibility_t &cached = splashVisibility[ G_SplashVisibilityHash( origin, ent->s.number ) ];
+
+	// a hash collision just replaces the older entry
+	if ( cached.entityNum == ent->s.number && cached.generation == ent->generation &&
+	     VectorCompare( cached.origin, origin ) &&
+	     VectorCompare( cached.absmin, ent->r.absmin ) && VectorCompare( cached.absmax, ent->r.absmax ) )
+	{
+		splash.numCached++;
+		return cached.visible;
+	}
+
+	VectorCopy( origin, cached.origin );
+	cached.entityNum = ent->s.number;
+	cached.generation = ent->generation;
+	VectorCopy( ent->r.absmin, cached.absmin );
+	VectorCopy( ent->r.absmax, cached.absmax );
+	cached.visible = G_CanDamageTraces( ent, origin, &splash.numTraces );
+
+	return cached.visible;
+}
+
+static void G_SplashDebug( const splashDamage_t &splash, const vec3_t origin, int mod )
+{
+	if ( g_debugDamage.integer > 1 )
+	{
+		Log::Notice( "splash damage (%s) at %s: %d candidates, %d traces, %d cached",
+		             modNames[ mod ], vtos( origin ), ( int ) splash.candidates.size(), splash.numTraces,
+		             splash.numCached );
+	}
+}
+
+bool G_SelectiveRadiusDamage( vec3_t origin, gentity_t *attacker, float damage,
+                                  float radius, gentity_t *ignore, int mod, int ignoreTeam )
+{
+	splashDamage_t splash;
+	bool  hitClient = false;
+
+	if ( radius < 1 )
+	{
+		radius = 1;
+	}
+
+	G_SplashGather( splash, origin, radius, ignore, [ ignoreTeam ]( gentity_t *ent ) {
+		return !( ent->flags & FL_NOTARGET ) && ent->client && ent->client->pers.team != ignoreTeam;
+	} );
+
+	for ( splashCandidate_t &candidate : splash.candidates )
+	{
+		if ( !G_SplashVisible( splash, candidate, origin ) )
 		{
-			hitClient = ent->entity->Damage(points, attacker, Vec3::Load(origin), Util::nullopt,
-			                                DAMAGE_NO_LOCDAMAGE, (meansOfDeath_t)mod);
+			continue;
 		}
+
+		float points = damage * ( 1.0 - candidate.dist / radius );
+
+		hitClient = candidate.ent->entity->Damage(points, attacker, Vec3::Load(origin), Util::nullopt,
+		                                          DAMAGE_NO_LOCDAMAGE, (meansOfDeath_t)mod);
 	}
 
+	G_SplashDebug( splash, origin, mod );
+
 	return hitClient;
 }
 
 bool G_RadiusDamage( vec3_t origin, gentity_t *attacker, float damage,
                          float radius, gentity_t *ignore, int dflags, int mod, team_t testHit )
 {
-	float     points, dist;
-	gentity_t *ent;
-	int       entityList[ MAX_GENTITIES ];
-	int       numListedEntities;
-	vec3_t    mins, maxs;
+	splashDamage_t splash;
 	vec3_t    dir;
-	int       i, e;
 	bool  hitSomething = false;
 
 	if ( radius < 1 )
@@ -936,53 +1135,49 @@ bool G_RadiusDamage( vec3_t origin, gentity_t *attacker, float damage,
 		radius = 1;
 	}
 
-	for ( i = 0; i < 3; i++ )
+	if ( testHit != TEAM_NONE )
 	{
-		mins[ i ] = origin[ i ] - radius;
-		maxs[ i ] = origin[ i ] + radius;
-	}
+		G_SplashGather( splash, origin, radius, ignore, [ testHit ]( gentity_t *ent ) {
+			return G_Team( ent ) == testHit && Entities::IsAlive( ent );
+		} );
 
-	numListedEntities = trap_EntitiesInBox( mins, maxs, entityList, MAX_GENTITIES );
-
-	for ( e = 0; e < numListedEntities; e++ )
-	{
-		ent = &g_entities[ entityList[ e ] ];
-
-		if ( ent == ignore )
+		for ( splashCandidate_t &candidate : splash.candidates )
 		{
-			continue;
+			if ( G_SplashVisible( splash, candidate, origin ) )
+			{
+				return true;
+			}
 		}
 
-		// find the distance from the edge of the bounding box
-		dist = G_DistanceToBBox( origin, ent );
+		return false;
+	}
+
+	G_SplashGather( splash, origin, radius, ignore, []( gentity_t * ) {
+		return true;
+	} );
 
-		if ( dist >= radius )
+	for ( splashCandidate_t &candidate : splash.candidates )
+	{
+		if ( !G_SplashVisible( splash, candidate, origin ) )
 		{
 			continue;
 		}
 
-		points = damage * ( 1.0 - dist / radius );
+		gentity_t *ent = candidate.ent.entity;
+		float     points = damage * ( 1.0 - candidate.dist / radius );
 
-		if ( G_CanDamage( ent, origin ) )
-		{
-			if ( testHit == TEAM_NONE )
-			{
-				VectorSubtract( ent->r.currentOrigin, origin, dir );
-				// push the center of mass higher than the origin so players
-				// get knocked into the air more
-				dir[ 2 ] += 24;
-				VectorNormalize( dir );
-
-				hitSomething = ent->entity->Damage(points, attacker, Vec3::Load(origin), Vec3::Load(dir),
-				                                   (DAMAGE_NO_LOCDAMAGE | dflags), (meansOfDeath_t)mod);
-			}
-			else if ( G_Team( ent ) == testHit && Entities::IsAlive( ent ) )
-			{
-				return true;
-			}
-		}
+		VectorSubtract( ent->r.currentOrigin, origin, dir );
+		// push the center of mass higher than the origin so players
+		// get knocked into the air more
+		dir[ 2 ] += 24;
+		VectorNormalize( dir );
+
+		hitSomething = ent->entity->Damage(points, attacker, Vec3::Load(origin), Vec3::Load(dir),
+		                                   (DAMAGE_NO_LOCDAMAGE | dflags), (meansOfDeath_t)mod);
 	}
 
+	G_SplashDebug( splash, origin, mod );
+
 	return hitSomething;
 }
 
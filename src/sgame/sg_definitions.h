@@ -47,11 +47,14 @@ along with Unvanquished Source Code.  If not, see <http://www.gnu.org/licenses/>
 #define DAMAGE_NO_PROTECTION 0x00000004 /**< Game settings don't prevent damage. */
 #define DAMAGE_NO_LOCDAMAGE  0x00000008 /**< Don't apply locational modifier. */
 
+#define DAMAGE_LEDGER_INLINE 4 // damage credits per entity that don't need an allocation
+
 #define MAX_DAMAGE_REGIONS     16
 #define MAX_DAMAGE_REGION_TEXT 8192
 
 #define MAX_NAME_CHARACTERS 32
 
 #define FOFS(x) ((size_t)&(((gentity_t *)0 )->x ))
+#define SOFS(x) ((size_t)&(((gentityScript_t *)0 )->x ))
 
 #endif // SG_DEFINITIONS_H_
@@ -64,6 +64,132 @@ void G_InitGentity( gentity_t *entity )
 	entity->creationTime = level.time;
 }
 
+/*
+=================================================================================
+
+entity slot allocator
+
+Free slots above MAX_CLIENTS are kept in a queue in the order in which they were
+freed, so the slot at the front is always the one that has been free the longest
+and finding a reusable slot doesn't need to scan g_entities.
+
+=================================================================================
+*/
+
+// a slot is only queued while it is free, so the queue can never overflow
+static struct
+{
+	int queue[ MAX_GENTITIES ];
+	int head;
+	int count;
+
+	// statistics
+	int peakEntities;   // highest number of entities in use at the same time
+	int peakSlots;      // highest level.num_entities
+	int inUse;          // non-client entities in use
+	int forcedReuses;   // slots reused before the end of the reuse delay
+	int secondStart;    // level.time when the current churn second started
+	int secondAllocs;
+	int secondFrees;
+	int lastAllocs;     // allocations during the last full second
+	int lastFrees;
+	int peakAllocs;     // most allocations during one second
+	int64_t totalAllocs;
+} entityAllocator;
+
+/*
+=================
+G_InitEntityAllocator
+
+Called when g_entities has been cleared for a new game.
+=================
+*/
+void G_InitEntityAllocator()
+{
+	memset( &entityAllocator, 0, sizeof( entityAllocator ) );
+	entityAllocator.secondStart = level.time;
+	entityAllocator.peakSlots = level.num_entities;
+}
+
+static void G_EntityAllocatorCountChurn()
+{
+	if ( level.time - entityAllocator.secondStart < 1000 )
+	{
+		return;
+	}
+
+	// nothing was allocated or freed during the last full second if the
+	// counters haven't been rolled over for more than a second
+	if ( level.time - entityAllocator.secondStart < 2000 )
+	{
+		entityAllocator.lastAllocs = entityAllocator.secondAllocs;
+		entityAllocator.lastFrees = entityAllocator.secondFrees;
+	}
+	else
+	{
+		entityAllocator.lastAllocs = 0;
+		entityAllocator.lastFrees = 0;
+	}
+
+	entityAllocator.peakAllocs = std::max( entityAllocator.peakAllocs, entityAllocator.secondAllocs );
+	entityAllocator.secondAllocs = 0;
+	entityAllocator.secondFrees = 0;
+	entityAllocator.secondStart = level.time;
+}
+
+static void G_EntityAllocatorPush( int slot )
+{
+	int tail = ( entityAllocator.head + entityAllocator.count ) % MAX_GENTITIES;
+
+	entityAllocator.queue[ tail ] = slot;
+	entityAllocator.count++;
+}
+
+/*
+=================
+G_EntityAllocatorPop
+
+Returns the slot that has been free for the longest time, or -1 if that slot
+is still within its reuse delay (in which case all other queued slots are as
+well) and force is false.
+=================
+*/
+static int G_EntityAllocatorPop( bool force )
+{
+	while ( entityAllocator.count )
+	{
+		int slot = entityAllocator.queue[ entityAllocator.head ];
+		const gentity_t *ent = &g_entities[ slot ];
+
+		// the first couple seconds of server time can involve a lot of
+		// freeing and allocating, so relax the replacement policy
+		bool delayed = ent->freetime > level.startTime + 2000 && level.time - ent->freetime < 1000;
+
+		if ( delayed && !force && !ent->inuse )
+		{
+			return -1;
+		}
+
+		entityAllocator.head = ( entityAllocator.head + 1 ) % MAX_GENTITIES;
+		entityAllocator.count--;
+
+		// should not happen, but never hand out a slot twice
+		if ( ent->inuse )
+		{
+			continue;
+		}
+
+		if ( delayed )
+		{
+			entityAllocator.forcedReuses++;
+		}
+
+		return slot;
+	}
+
+	return -1;
+}
+
 /*
 =================
 G_NewEntity
@@ -76,64 +202,49 @@ never be used by anything else.
 Try to avoid reusing an entity that was recently freed, because it
 can cause the client to think the entity morphed into something else
 instead of being removed and recreated, which can cause interpolated
-angles and bad trails.
+angles and bad trails. Opening a new slot is preferred over reusing a
+recently freed one, and the other way around only when all slots are taken.
 =================
 */
 gentity_t *G_NewEntity()
 {
-	int       i, force;
 	gentity_t *newEntity;
+	int       slot;
 
-	newEntity = nullptr; // shut up warning
-	i = 0; // shut up warning
+	G_EntityAllocatorCountChurn();
 
-	for ( force = 0; force < 2; force++ )
-	{
-		// if we go through all entities first and can't find a free one,
-		// then try again a second time, this time ignoring times
-		newEntity = &g_entities[ MAX_CLIENTS ];
+	slot = G_EntityAllocatorPop( level.num_entities >= ENTITYNUM_MAX_NORMAL );
 
-		for ( i = MAX_CLIENTS; i < level.num_entities; i++, newEntity++ )
+	if ( slot >= 0 )
+	{
+		newEntity = &g_entities[ slot ];
+	}
+	else
+	{
+		if ( level.num_entities >= ENTITYNUM_MAX_NORMAL )
 		{
-			if ( newEntity->inuse )
-			{
-				continue;
-			}
-
-			// the first couple seconds of server time can involve a lot of
-			// freeing and allocating, so relax the replacement policy
-			if ( !force && newEntity->freetime > level.startTime + 2000 && level.time - newEntity->freetime < 1000 )
+			for ( int i = 0; i < MAX_GENTITIES; i++ )
 			{
-				continue;
+				Log::Warn( "%4i: %s", i, g_entities[ i ].classname );
 			}
 
-			// reuse this slot
-			G_InitGentity( newEntity );
-			return newEntity;
-		}
-
-		if ( i != MAX_GENTITIES )
-		{
-			break;
+			Sys::Drop( "G_Spawn: no free entities" );
 		}
-	}
 
-	if ( i == ENTITYNUM_MAX_NORMAL )
-	{
-		for ( i = 0; i < MAX_GENTITIES; i++ )
-		{
-			Log::Warn( "%4i: %s", i, g_entities[ i ].classname );
-		}
+		// open up a new slot
+		newEntity = &g_entities[ level.num_entities ];
+		level.num_entities++;
+		entityAllocator.peakSlots = std::max( entityAllocator.peakSlots, level.num_entities );
 
-		Sys::Drop( "G_Spawn: no free entities" );
+		// let the server system know that there are more entities
+		trap_LocateGameData( level.num_entities, sizeof( gentity_t ),
+		                     sizeof( level.clients[ 0 ] ) );
 	}
 
-	// open up a new slot
-	level.num_entities++;
-
-	// let the server system know that there are more entities
-	trap_LocateGameData( level.num_entities, sizeof( gentity_t ),
-	                     sizeof( level.clients[ 0 ] ) );
+	entityAllocator.inUse++;
+	entityAllocator.peakEntities = std::max( entityAllocator.peakEntities, entityAllocator.inUse );
+	entityAllocator.secondAllocs++;
+	entityAllocator.totalAllocs++;
 
 	G_InitGentity( newEntity );
 	return newEntity;
@@ -148,6 +259,8 @@ Marks the entity as free
 */
 void G_FreeEntity( gentity_t *entity )
 {
+	bool wasInUse = entity->inuse;
+
 	trap_UnlinkEntity( entity );  // unlink from world
 
 	if ( g_debugEntities.integer > 2 )
@@ -176,6 +289,13 @@ void G_FreeEntity( gentity_t *entity )
 		delete entity->entity;
 	}
 
+	if ( entity->script )
+	{
+		BG_Free( entity->script );
+	}
+
+	G_ClearDamageCredits( entity );
+
 	unsigned generation = entity->generation;
 	memset( entity, 0, sizeof( *entity ) );
 	entity->generation = generation + 1;
@@ -183,6 +303,68 @@ void G_FreeEntity( gentity_t *entity )
 	entity->classname = "freent";
 	entity->freetime = level.time;
 	entity->inuse = false;
+
+	// client slots are handed out by the engine
+	if ( wasInUse && entity - g_entities >= MAX_CLIENTS && entity - g_entities < ENTITYNUM_MAX_NORMAL )
+	{
+		G_EntityAllocatorCountChurn();
+		G_EntityAllocatorPush( entity - g_entities );
+		entityAllocator.inUse--;
+		entityAllocator.secondFrees++;
+	}
+}
+
+/*
+=================
+G_ScriptData
+
+Returns the map scripting data of an entity, which is created on first use.
+=================
+*/
+gentityScript_t *G_ScriptData( gentity_t *entity )
+{
+	if ( !entity->script )
+	{
+		entity->script = ( gentityScript_t * ) BG_Alloc( sizeof( *entity->script ) );
+	}
+
+	return entity->script;
+}
+
+/*
+=================
+G_EntityStats_f
+
+Prints the entity allocation statistics of the current game.
+=================
+*/
+void G_EntityStats_f()
+{
+	int withScript = 0;
+	int withCredits = 0;
+	int withExtraCredits = 0;
+
+	G_EntityAllocatorCountChurn();
+
+	for ( int i = 0; i < level.num_entities; i++ )
+	{
+		withScript += g_entities[ i ].script != nullptr;
+		withCredits += g_entities[ i ].damageLedger.numCredits > 0;
+		withExtraCredits += g_entities[ i ].damageLedger.extra != nullptr;
+	}
+
+	Log::Notice( "entities in use: %d (peak %d)", entityAllocator.inUse, entityAllocator.peakEntities );
+	Log::Notice( "slots: %d of %d (peak %d), %d free",
+	             level.num_entities - MAX_CLIENTS, ENTITYNUM_MAX_NORMAL - MAX_CLIENTS,
+	             entityAllocator.peakSlots - MAX_CLIENTS, entityAllocator.count );
+	Log::Notice( "churn: %d allocations and %d frees during the last second (peak %d/s)",
+	             entityAllocator.lastAllocs, entityAllocator.lastFrees, entityAllocator.peakAllocs );
+	Log::Notice( "total allocations: %d, reused within the reuse delay: %d",
+	             ( int ) entityAllocator.totalAllocs, entityAllocator.forcedReuses );
+	Log::Notice( "entity size: %d bytes, %d with script data (%d bytes each)",
+	             ( int ) sizeof( gentity_t ), withScript, ( int ) sizeof( gentityScript_t ) );
+	Log::Notice( "damage credits: %d entities, %d of them with more than %d attackers",
+	             withCredits, withExtraCredits, DAMAGE_LEDGER_INLINE );
 }
 
 
@@ -411,6 +593,93 @@ gentity_t *G_IterateEntitiesWithinRadius( gentity_t *entity, vec3_t origin, floa
 	return nullptr;
 }
 
+/*
+=============
+G_EntitiesInBox
+
+Fills list with the linked entities whose bounds touch the box and that pass
+the filter, and returns their number. The world broadphase is used to find
+them, so unlike the G_IterateEntities* functions this doesn't depend on the
+number of entities in the game.
+=============
+*/
+int G_EntitiesInBox( const vec3_t mins, const vec3_t maxs, gentity_t **list, int maxcount,
+                     const entityFilter_t &filter )
+{
+	int entityList[ MAX_GENTITIES ];
+	int numListedEntities = trap_EntitiesInBox( mins, maxs, entityList, MAX_GENTITIES );
+	int count = 0;
+
+	for ( int i = 0; i < numListedEntities && count < maxcount; i++ )
+	{
+		gentity_t *ent = &g_entities[ entityList[ i ] ];
+
+		if ( !ent->inuse )
+		{
+			continue;
+		}
+
+		if ( filter.eType && ent->s.eType != *filter.eType )
+		{
+			continue;
+		}
+
+		if ( filter.team != TEAM_ALL && G_Team( ent ) != filter.team )
+		{
+			continue;
+		}
+
+		if ( filter.accept && !filter.accept( ent ) )
+		{
+			continue;
+		}
+
+		list[ count++ ] = ent;
+	}
+
+	return count;
+}
+
+/*
+=============
+G_EntitiesWithinRadius
+
+Like G_EntitiesInBox, for the linked entities whose center is within radius
+of origin, as in G_IterateEntitiesWithinRadius.
+=============
+*/
+int G_EntitiesWithinRadius( const vec3_t origin, float radius, gentity_t **list, int maxcount,
+                            const entityFilter_t &filter )
+{
+	vec3_t mins, maxs, center;
+	int    count = 0;
+
+	for ( int i = 0; i < 3; i++ )
+	{
+		mins[ i ] = origin[ i ] - radius;
+		maxs[ i ] = origin[ i ] + radius;
+	}
+
+	int numListedEntities = G_EntitiesInBox( mins, maxs, list, maxcount, filter );
+
+	for ( int i = 0; i < numListedEntities; i++ )
+	{
+		gentity_t *ent = list[ i ];
+
+		VectorAdd( ent->r.mins, ent->r.maxs, center );
+		VectorMA( ent->r.currentOrigin, 0.5f, center, center );
+
+		if ( DistanceSquared( origin, center ) > Square( radius ) )
+		{
+			continue;
+		}
+
+		list[ count++ ] = ent;
+	}
+
+	return count;
+}
+
 /*
 ===============
 G_FindClosestEntity
@@ -623,20 +892,27 @@ gentity_t *G_IterateTargets(gentity_t *entity, int *targetIndex, gentity_t *self
 
 gentity_t *G_IterateCallEndpoints(gentity_t *entity, int *calltargetIndex, gentity_t *self)
 {
+	gentityCallDefinition_t *calltargets;
+
+	if (!self->script)
+		return nullptr;
+
+	calltargets = self->script->calltargets;
+
 	if (entity)
 		goto cont;
 
-	for (*calltargetIndex = 0; self->calltargets[*calltargetIndex].name; ++(*calltargetIndex))
+	for (*calltargetIndex = 0; calltargets[*calltargetIndex].name; ++(*calltargetIndex))
 	{
-		if(self->calltargets[*calltargetIndex].name[0] == '$')
-			return G_ResolveEntityKeyword( self, self->calltargets[*calltargetIndex].name );
+		if(calltargets[*calltargetIndex].name[0] == '$')
+			return G_ResolveEntityKeyword( self, calltargets[*calltargetIndex].name );
 
 		for( entity = &g_entities[ MAX_CLIENTS ]; entity < &g_entities[ level.num_entities ]; entity++ )
 		{
 			if ( !entity->inuse )
 				continue;
 
-			if( G_MatchesName(entity, self->calltargets[*calltargetIndex].name) )
+			if( G_MatchesName(entity, calltargets[*calltargetIndex].name) )
 				return entity;
 
 			cont: ;
@@ -693,7 +969,7 @@ void G_FireEntityRandomly( gentity_t *entity, gentity_t *activator )
 	while( ( possibleTarget = G_IterateCallEndpoints( possibleTarget, &targetIndex, entity ) ) != nullptr )
 	{
 		choices[ totalChoiceCount ].recipient = possibleTarget;
-		choices[ totalChoiceCount ].callDefinition = &entity->calltargets[targetIndex];
+		choices[ totalChoiceCount ].callDefinition = &entity->script->calltargets[targetIndex];
 		totalChoiceCount++;
 	}
 
@@ -729,13 +1005,13 @@ void G_EventFireEntity( gentity_t *self, gentity_t *activator, gentityCallEvent_
 
 	while( ( currentTarget = G_IterateCallEndpoints( currentTarget, &targetIndex, self ) ) != nullptr )
 	{
-		if( eventType && self->calltargets[ targetIndex ].eventType != eventType )
+		if( eventType && self->script->calltargets[ targetIndex ].eventType != eventType )
 		{
 			continue;
 		}
 
 		call.caller = self; //reset the caller in case there have been nested calls
-		call.definition = &self->calltargets[ targetIndex ];
+		call.definition = &self->script->calltargets[ targetIndex ];
 
 		G_CallEntity(currentTarget, &call);
 
@@ -215,15 +215,28 @@ struct gentityCall_t
 	gentity_t *activator;
 };
 
+/**
+ * Optional filters of the spatial entity queries, the defaults let every entity pass.
+ */
+struct entityFilter_t
+{
+	team_t                        team = TEAM_ALL; // as returned by G_Team
+	Util::optional<entityType_t>  eType;
+	bool                          ( *accept )( gentity_t *ent ) = nullptr; // e.g. Entities::HasHealthComponent
+};
+
 //
 // g_entities.c
 //
 //lifecycle
 void       G_InitGentityMinimal( gentity_t *e );
 void       G_InitGentity( gentity_t *e );
+void       G_InitEntityAllocator();
 gentity_t  *G_NewEntity();
 gentity_t  *G_NewTempEntity( const vec3_t origin, int event );
 void       G_FreeEntity( gentity_t *e );
+gentityScript_t *G_ScriptData( gentity_t *e );
+void       G_EntityStats_f();
 
 //debug
 const char *etos( const gentity_t *entity );
@@ -235,6 +248,10 @@ gentity_t  *G_IterateEntities( gentity_t *entity );
 gentity_t  *G_IterateEntitiesOfClass( gentity_t *entity, const char *classname );
 gentity_t  *G_IterateEntitiesWithField( gentity_t *entity, size_t fieldofs, const char *match );
 gentity_t  *G_IterateEntitiesWithinRadius( gentity_t *entity, vec3_t origin, float radius );
+int        G_EntitiesInBox( const vec3_t mins, const vec3_t maxs, gentity_t **list, int maxcount,
+                            const entityFilter_t &filter = {} );
+int        G_EntitiesWithinRadius( const vec3_t origin, float radius, gentity_t **list, int maxcount,
+                                   const entityFilter_t &filter = {} );
 gentity_t  *G_FindClosestEntity( vec3_t origin, gentity_t **entities, int numEntities );
 gentity_t  *G_PickRandomEntity( const char *classname, size_t fieldofs, const char *match );
 gentity_t  *G_PickRandomEntityOfClass( const char *classname );
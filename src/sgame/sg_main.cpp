@@ -28,6 +28,10 @@ Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
 #include "Entities.h"
 #include "CBSE.h"
 #include "backend/CBSEBackend.h"
+#include "sg_cm_world.h"
+#include "sg_profiler.h"
+#include "sg_pmovereplay.h"
+#include "sg_targets.h"
 
 #define INTERMISSION_DELAY_TIME 1000
 
@@ -701,6 +705,9 @@ void G_InitGame( int levelTime, int randomSeed, bool inClient )
 	Log::Notice( "gamename: %s", GAME_VERSION );
 	Log::Notice( "gamedate: %s", __DATE__ );
 
+	// what is allocated for this map is released in one go in G_ShutdownGame
+	BG_BeginMapArena();
+
 	// set some level globals
 	memset( &level, 0, sizeof( level ) );
 	level.time = levelTime;
@@ -822,6 +829,8 @@ void G_InitGame( int levelTime, int randomSeed, bool inClient )
 	// always leave room for the max number of clients, even if they aren't all used, so numbers
 	// inside that range are NEVER anything but clients
 	level.num_entities = MAX_CLIENTS;
+	G_InitEntityAllocator();
+	ThinkingComponent::ResetSchedule();
 
 	for( i = 0; i < MAX_CLIENTS; i++ )
 	{
@@ -847,6 +856,7 @@ void G_InitGame( int levelTime, int randomSeed, bool inClient )
 
 	// add any fake entities
 	G_SpawnFakeEntities();
+	G_BuildLocationIndex();
 
 	BaseClustering::Init();
 
@@ -983,6 +993,10 @@ void G_ShutdownGame( int /* restart */ )
 	// write all the client session data so we can get it back
 	G_WriteSessionData();
 
+	G_ProfileShutdown();
+	G_PmoveRecordShutdown();
+	G_TargetIndexShutdown();
+
 	G_admin_cleanup();
 	G_BotCleanup();
 	G_namelog_cleanup();
@@ -1008,6 +1022,9 @@ void G_ShutdownGame( int /* restart */ )
 	}
 
 	delete level.emptyEntity;
+
+	// everything that held on to map allocations was cleaned up above
+	BG_ReleaseMapArena();
 }
 
 //===================================================================
@@ -2639,6 +2656,16 @@ void G_RunFrame( int levelTime )
 	int        msec;
 	static int ptime3000 = 0;
 
+	// traces are also done while paused, so the broadphase statistics roll over
+	// and its changes are applied on every frame, however it ends
+	struct cmFrameEnd_t
+	{
+		~cmFrameEnd_t()
+		{
+			G_CM_EndFrame();
+		}
+	} cmFrameEnd;
+
 	// if we are waiting for the level to restart, do nothing
 	if ( level.restarted )
 	{
@@ -2697,6 +2724,8 @@ void G_RunFrame( int levelTime )
 		return;
 	}
 
+	G_ProfileScope frameProfile( PROFILE_FRAME );
+
 	level.framenum++;
 	level.previousTime = level.time;
 	level.time = levelTime;
@@ -2716,7 +2745,10 @@ void G_RunFrame( int levelTime )
 
 	G_CheckPmoveParamChanges();
 
+	ThinkingComponent::BeginFrame();
+
 	// go through all allocated objects
+	G_ProfileScope entitiesProfile( PROFILE_ENTITIES );
 	ent = &g_entities[ 0 ];
 	for ( i = 0; i < level.num_entities; i++, ent++ )
 	{
@@ -2761,36 +2793,51 @@ void G_RunFrame( int levelTime )
 		switch ( ent->s.eType )
 		{
 			case entityType_t::ET_MISSILE:
+			{
+				G_ProfileScope profile( PROFILE_MISSILES );
 				G_RunMissile( ent );
 				continue;
+			}
 
 			case entityType_t::ET_BUILDABLE:
+			{
+				G_ProfileScope profile( PROFILE_BUILDABLES );
 				// TODO: Do buildables make any use of G_Physics' functionality apart from the call
 				//       to G_RunThink?
 				G_Physics( ent, msec );
 				continue;
+			}
 
 			case entityType_t::ET_CORPSE:
+			{
+				G_ProfileScope profile( PROFILE_CORPSES );
 				G_Physics( ent, msec );
 				continue;
+			}
 
 			case entityType_t::ET_MOVER:
+			{
+				G_ProfileScope profile( PROFILE_MOVERS );
 				G_RunMover( ent );
 				continue;
+			}
 
 			default:
 				if ( ent->physicsObject )
 				{
+					G_ProfileScope profile( PROFILE_PHYSICS );
 					G_Physics( ent, msec );
 					continue;
 				}
 				else if ( i < MAX_CLIENTS )
 				{
+					G_ProfileScope profile( PROFILE_CLIENTS );
 					G_RunClient( ent );
 					continue;
 				}
 				else
 				{
+					G_ProfileScope profile( PROFILE_THINK );
 					G_RunThink( ent );
 
 					// allow entities to free themselves before acting
@@ -2804,18 +2851,15 @@ void G_RunFrame( int levelTime )
 		}
 	}
 
+	entitiesProfile.Stop();
+
 	// ThinkingComponent should have been called already but who knows maybe we forgot some.
-	ForEntities<ThinkingComponent>([](Entity& entity, ThinkingComponent& thinkingComponent) {
-		// A newly created entity can randomly run things, or not, in the G_RunFrames loop over
-		// entities depending on whether it was added in a hole in g_entities or at the end, so
-		// ignore the entity if it was created this frame.
-		if (entity.oldEnt->creationTime != level.time && thinkingComponent.GetLastThinkTime() != level.time) {
-			Log::Warn("ThinkingComponent was not called");
-			thinkingComponent.Think();
-		}
-	});
+	G_ProfileScope thinkingProfile( PROFILE_THINKING_COMPONENTS );
+	ThinkingComponent::RunMissed();
+	thinkingProfile.Stop();
 
 	// perform final fixups on the players
+	G_ProfileScope endFrameProfile( PROFILE_CLIENT_END_FRAME );
 	ent = &g_entities[ 0 ];
 
 	for ( i = 0; i < level.maxclients; i++, ent++ )
@@ -2826,23 +2870,53 @@ void G_RunFrame( int levelTime )
 		}
 	}
 
+	endFrameProfile.Stop();
+
 	// save position information for all active clients
-	G_UnlaggedStore();
+	{
+		G_ProfileScope profile( PROFILE_UNLAGGED_STORE );
+		G_UnlaggedStore();
+	}
 
 	// Check if a build point can be removed from the queue.
-	G_RecoverBuildPoints();
+	{
+		G_ProfileScope profile( PROFILE_BUILD_POINTS );
+		G_RecoverBuildPoints();
+	}
 
 	// Power down buildables if there is a budget deficit.
-	G_UpdateBuildablePowerStates();
+	{
+		G_ProfileScope profile( PROFILE_POWER_STATES );
+		G_UpdateBuildablePowerStates();
+	}
+
+	{
+		G_ProfileScope profile( PROFILE_MOMENTUM );
+		G_DecreaseMomentum();
+	}
 
-	G_DecreaseMomentum();
 	G_CalculateAvgPlayers();
-	G_SpawnClients( TEAM_ALIENS );
-	G_SpawnClients( TEAM_HUMANS );
-	G_UpdateZaps( msec );
-	Beacon::Frame( );
 
-	G_PrepareEntityNetCode();
+	{
+		G_ProfileScope profile( PROFILE_SPAWN_CLIENTS );
+		G_SpawnClients( TEAM_ALIENS );
+		G_SpawnClients( TEAM_HUMANS );
+	}
+
+	{
+		G_ProfileScope profile( PROFILE_ZAPS );
+		G_UpdateZaps( msec );
+	}
+
+	{
+		G_ProfileScope profile( PROFILE_BEACONS );
+		Beacon::Frame( );
+	}
+
+	{
+		G_ProfileScope profile( PROFILE_NETCODE );
+		G_PrepareEntityNetCode();
+	}
 
 	// log gameplay statistics
 	G_LogGameplayStats( LOG_GAMEPLAY_STATS_BODY );
@@ -2850,10 +2924,16 @@ void G_RunFrame( int levelTime )
 	// see if it is time to end the level
 	CheckExitRules();
 
-	G_BotFill( false );
+	{
+		G_ProfileScope profile( PROFILE_BOT_FILL );
+		G_BotFill( false );
+	}
 
 	// update to team status?
-	CheckTeamStatus();
+	{
+		G_ProfileScope profile( PROFILE_TEAM_STATUS );
+		CheckTeamStatus();
+	}
 
 	// cancel vote if timed out
 	for ( i = 0; i < NUM_TEAMS; i++ )
@@ -2861,7 +2941,14 @@ void G_RunFrame( int levelTime )
 		G_CheckVote( (team_t) i );
 	}
 
-	trap_BotUpdateObstacles();
+	{
+		G_ProfileScope profile( PROFILE_BOT_OBSTACLES );
+		trap_BotUpdateObstacles();
+	}
+
+	frameProfile.Stop();
+	G_ProfileEndFrame();
+
 	level.frameMsec = trap_Milliseconds();
 }
 
@@ -0,0 +1,414 @@
+/*
+===========================================================================
+
+Unvanquished GPL Source Code
+Copyright (C) 2026 Unvanquished Developers
+
+This file is part of the Unvanquished GPL Source Code (Unvanquished Source Code).
+
+Unvanquished is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Unvanquished is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Unvanquished.  If not, see <http://www.gnu.org/licenses/>.
+
+===========================================================================
+*/
+
+// sg_pmovereplay.cpp -- recording of client moves and their replay as a benchmark
+//
+// With g_pmoveRecord set, the input and the result of every client move is
+// written to a file. pmoveReplay runs the recorded moves through Pmove again on
+// the same map, measures how fast they are and checks that every move still
+// produces exactly the recorded player state. Moves blocked by other entities
+// can only be reproduced if those are at the same place, so record on a map
+// without other players, or expect some divergence.
+
+#include "sg_local.h"
+#include "sg_pmovereplay.h"
+
+#define PMOVE_RECORD_MAGIC   "PMRC"
+#define PMOVE_RECORD_VERSION 1
+
+// the file is opened or closed on the next move, out of the cvar system
+static bool pmoveRecordChanged = true;
+
+static Cvar::Callback<Cvar::Cvar<std::string>> g_pmoveRecord(
+	"g_pmoveRecord", "file to record the moves of all clients to, for pmoveReplay", Cvar::NONE, "",
+	[](const std::string&) {
+		pmoveRecordChanged = true;
+	});
+
+struct pmoveRecordHeader_t
+{
+	char magic[ 4 ];
+	int  version;
+	int  recordSize; // changes with the layout of playerState_t
+	char map[ MAX_QPATH ];
+};
+
+struct pmoveRecord_t
+{
+	// input
+	playerState_t before;
+	pmoveExt_t    extBefore;
+	usercmd_t     cmd;
+	int           tracemask;
+	bool          noFootsteps;
+	bool          autoWeaponHit[ 32 ];
+	bool          pmove_fixed;
+	int           pmove_msec;
+	int           pmove_accurate;
+
+	// result
+	playerState_t after;
+	pmoveExt_t    extAfter;
+};
+
+static struct
+{
+	fileHandle_t  file;
+	std::string   fileName;
+	pmoveRecord_t pending;
+} recorder;
+
+static void G_PmoveRecordClose()
+{
+	if ( recorder.file )
+	{
+		trap_FS_FCloseFile( recorder.file );
+		recorder.file = 0;
+	}
+
+	recorder.fileName.clear();
+}
+
+/*
+================
+G_PmoveRecordUpdate
+
+Opens or closes the record file when g_pmoveRecord changes.
+================
+*/
+static void G_PmoveRecordUpdate()
+{
+	if ( !pmoveRecordChanged )
+	{
+		return;
+	}
+
+	pmoveRecordChanged = false;
+
+	std::string name = g_pmoveRecord.Get();
+
+	if ( name == recorder.fileName )
+	{
+		return;
+	}
+
+	G_PmoveRecordClose();
+	recorder.fileName = name;
+
+	if ( name.empty() )
+	{
+		return;
+	}
+
+	trap_FS_FOpenFile( name.c_str(), &recorder.file, fsMode_t::FS_WRITE );
+
+	if ( !recorder.file )
+	{
+		Log::Warn( "Couldn't open pmove record: %s", name );
+		return;
+	}
+
+	pmoveRecordHeader_t header{};
+
+	memcpy( header.magic, PMOVE_RECORD_MAGIC, sizeof( header.magic ) );
+	header.version = PMOVE_RECORD_VERSION;
+	header.recordSize = sizeof( pmoveRecord_t );
+	trap_Cvar_VariableStringBuffer( "mapname", header.map, sizeof( header.map ) );
+
+	trap_FS_Write( &header, sizeof( header ), recorder.file );
+}
+
+void G_PmoveRecordStart( const pmove_t *pm )
+{
+	G_PmoveRecordUpdate();
+
+	if ( !recorder.file )
+	{
+		return;
+	}
+
+	pmoveRecord_t &record = recorder.pending;
+
+	record.before = *pm->ps;
+	record.extBefore = *pm->pmext;
+	record.cmd = pm->cmd;
+	record.tracemask = pm->tracemask;
+	record.noFootsteps = pm->noFootsteps;
+	memcpy( record.autoWeaponHit, pm->autoWeaponHit, sizeof( record.autoWeaponHit ) );
+	record.pmove_fixed = pm->pmove_fixed;
+	record.pmove_msec = pm->pmove_msec;
+	record.pmove_accurate = pm->pmove_accurate;
+}
+
+void G_PmoveRecordFinish( const pmove_t *pm )
+{
+	if ( !recorder.file )
+	{
+		return;
+	}
+
+	recorder.pending.after = *pm->ps;
+	recorder.pending.extAfter = *pm->pmext;
+
+	trap_FS_Write( &recorder.pending, sizeof( recorder.pending ), recorder.file );
+}
+
+void G_PmoveRecordShutdown()
+{
+	G_PmoveRecordClose();
+
+	// a restart of the map records again
+	pmoveRecordChanged = true;
+}
+
+/*
+ * Replay
+ */
+
+static int replayTraces;
+static int replayPointContents;
+
+static void G_ReplayTrace( trace_t *results, const vec3_t start, const vec3_t mins, const vec3_t maxs,
+                           const vec3_t end, int passEntityNum, int contentMask, int skipmask )
+{
+	replayTraces++;
+	trap_Trace( results, start, mins, maxs, end, passEntityNum, contentMask, skipmask );
+}
+
+static int G_ReplayPointContents( const vec3_t point, int passEntityNum )
+{
+	replayPointContents++;
+	return trap_PointContents( point, passEntityNum );
+}
+
+struct replayClassStats_t
+{
+	int     moves;
+	int     diverged;
+	int64_t traces;
+	int64_t pointContents;
+	int64_t microseconds;
+};
+
+/*
+================
+G_ReplayMove
+
+Runs a recorded move and returns whether it produced the recorded result.
+================
+*/
+static bool G_ReplayMove( const pmoveRecord_t &record, playerState_t &ps, pmoveExt_t &pmext )
+{
+	pmove_t pm;
+
+	memset( &pm, 0, sizeof( pm ) );
+
+	ps = record.before;
+	pmext = record.extBefore;
+
+	pm.ps = &ps;
+	pm.pmext = &pmext;
+	pm.cmd = record.cmd;
+	pm.tracemask = record.tracemask;
+	pm.trace = G_ReplayTrace;
+	pm.pointcontents = G_ReplayPointContents;
+	pm.noFootsteps = record.noFootsteps;
+	memcpy( pm.autoWeaponHit, record.autoWeaponHit, sizeof( pm.autoWeaponHit ) );
+	pm.pmove_fixed = record.pmove_fixed;
+	pm.pmove_msec = record.pmove_msec;
+	pm.pmove_accurate = record.pmove_accurate;
+
+	Pmove( &pm );
+
+	return !memcmp( &ps, &record.after, sizeof( ps ) ) &&
+	       !memcmp( &pmext, &record.extAfter, sizeof( pmext ) );
+}
+
+/*
+================
+G_PmoveReplay_f
+
+pmoveReplay <file> [repeat]
+
+Replays recorded moves and prints their speed and whether they still
+produce the recorded results, per class.
+================
+*/
+void G_PmoveReplay_f()
+{
+	char         fileName[ MAX_QPATH ];
+	char         arg[ 16 ];
+	char         map[ MAX_QPATH ];
+	fileHandle_t f;
+	int          repeat = 1;
+
+	if ( trap_Argc() < 2 )
+	{
+		Log::Notice( "usage: pmoveReplay <file> [repeat]" );
+		return;
+	}
+
+	trap_Argv( 1, fileName, sizeof( fileName ) );
+
+	if ( trap_Argc() > 2 )
+	{
+		trap_Argv( 2, arg, sizeof( arg ) );
+		repeat = std::max( 1, atoi( arg ) );
+	}
+
+	int len = trap_FS_FOpenFile( fileName, &f, fsMode_t::FS_READ );
+
+	if ( !f || len < (int) sizeof( pmoveRecordHeader_t ) )
+	{
+		Log::Warn( "Couldn't read pmove record: %s", fileName );
+
+		if ( f )
+		{
+			trap_FS_FCloseFile( f );
+		}
+
+		return;
+	}
+
+	pmoveRecordHeader_t header;
+	trap_FS_Read( &header, sizeof( header ), f );
+
+	if ( memcmp( header.magic, PMOVE_RECORD_MAGIC, sizeof( header.magic ) ) ||
+	     header.version != PMOVE_RECORD_VERSION || header.recordSize != sizeof( pmoveRecord_t ) )
+	{
+		Log::Warn( "%s is not a pmove record of this version of the game", fileName );
+		trap_FS_FCloseFile( f );
+		return;
+	}
+
+	header.map[ sizeof( header.map ) - 1 ] = '\0';
+	trap_Cvar_VariableStringBuffer( "mapname", map, sizeof( map ) );
+
+	if ( Q_stricmp( header.map, map ) )
+	{
+		Log::Warn( "%s was recorded on %s, the replay will diverge on %s", fileName, header.map, map );
+	}
+
+	int numRecords = ( len - (int) sizeof( header ) ) / (int) sizeof( pmoveRecord_t );
+	std::vector<pmoveRecord_t> records( numRecords );
+
+	trap_FS_Read( records.data(), numRecords * sizeof( pmoveRecord_t ), f );
+	trap_FS_FCloseFile( f );
+
+	if ( !numRecords )
+	{
+		Log::Notice( "%s holds no moves", fileName );
+		return;
+	}
+
+	replayClassStats_t stats[ PCL_NUM_CLASSES ] = {};
+	playerState_t      ps;
+	pmoveExt_t         pmext;
+	int                printedDivergences = 0;
+
+	for ( int pass = 0; pass < repeat; pass++ )
+	{
+		for ( int i = 0; i < numRecords; i++ )
+		{
+			const pmoveRecord_t &record = records[ i ];
+			int                 pClass = record.before.stats[ STAT_CLASS ];
+
+			if ( pClass < PCL_NONE || pClass >= PCL_NUM_CLASSES )
+			{
+				pClass = PCL_NONE;
+			}
+
+			replayClassStats_t &classStats = stats[ pClass ];
+
+			replayTraces = 0;
+			replayPointContents = 0;
+
+			auto start = Sys::SteadyClock::now();
+			bool same = G_ReplayMove( record, ps, pmext );
+			auto elapsed = Sys::SteadyClock::now() - start;
+
+			classStats.microseconds += std::chrono::duration_cast<std::chrono::microseconds>( elapsed ).count();
+			classStats.traces += replayTraces;
+			classStats.pointContents += replayPointContents;
+
+			// the passes only differ in timing
+			if ( pass )
+			{
+				continue;
+			}
+
+			classStats.moves++;
+
+			if ( same )
+			{
+				continue;
+			}
+
+			classStats.diverged++;
+
+			if ( printedDivergences++ < 10 )
+			{
+				Log::Notice( "move %d (%s, time %d) diverged: origin off by %.3f, velocity off by %.3f",
+				             i, BG_Class( pClass )->name, record.cmd.serverTime,
+				             Distance( ps.origin, record.after.origin ),
+				             Distance( ps.velocity, record.after.velocity ) );
+			}
+		}
+	}
+
+	Log::Notice( "%d moves replayed %d times:", numRecords, repeat );
+	Log::Notice( "%-12s %8s %10s %8s %8s %8s", "class", "moves", "moves/s", "traces", "points", "diverged" );
+
+	replayClassStats_t total = {};
+
+	for ( int i = PCL_NONE; i < PCL_NUM_CLASSES; i++ )
+	{
+		const replayClassStats_t &classStats = stats[ i ];
+
+		if ( !classStats.moves )
+		{
+			continue;
+		}
+
+		int64_t runs = (int64_t) classStats.moves * repeat;
+
+		Log::Notice( "%-12s %8d %10.0f %8.1f %8.1f %8d", BG_Class( i )->name, classStats.moves,
+		             runs * 1.0e6 / std::max<int64_t>( classStats.microseconds, 1 ),
+		             (float) classStats.traces / runs, (float) classStats.pointContents / runs,
+		             classStats.diverged );
+
+		total.moves += classStats.moves;
+		total.diverged += classStats.diverged;
+		total.traces += classStats.traces;
+		total.pointContents += classStats.pointContents;
+		total.microseconds += classStats.microseconds;
+	}
+
+	int64_t runs = (int64_t) total.moves * repeat;
+
+	Log::Notice( "%-12s %8d %10.0f %8.1f %8.1f %8d", "total", total.moves,
+	             runs * 1.0e6 / std::max<int64_t>( total.microseconds, 1 ),
+	             (float) total.traces / runs, (float) total.pointContents / runs,
+	             total.diverged );
+}
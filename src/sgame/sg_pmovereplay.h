@@ -0,0 +1,37 @@
+/*
+===========================================================================
+
+Unvanquished GPL Source Code
+Copyright (C) 2026 Unvanquished Developers
+
+This file is part of the Unvanquished GPL Source Code (Unvanquished Source Code).
+
+Unvanquished is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Unvanquished is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Unvanquished.  If not, see <http://www.gnu.org/licenses/>.
+
+===========================================================================
+*/
+
+// sg_pmovereplay.h -- recording of client moves and their replay as a benchmark
+
+#ifndef SG_PMOVEREPLAY_H_
+#define SG_PMOVEREPLAY_H_
+
+// wrap the Pmove of a client think to record it when g_pmoveRecord is set
+void G_PmoveRecordStart( const pmove_t *pm );
+void G_PmoveRecordFinish( const pmove_t *pm );
+void G_PmoveRecordShutdown();
+
+void G_PmoveReplay_f();
+
+#endif // SG_PMOVEREPLAY_H_
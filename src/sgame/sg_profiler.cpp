@@ -0,0 +1,294 @@
+/*
+===========================================================================
+
+Unvanquished GPL Source Code
+Copyright (C) 2026 Unvanquished Developers
+
+This file is part of the Unvanquished GPL Source Code (Unvanquished Source Code).
+
+Unvanquished is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Unvanquished is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Unvanquished.  If not, see <http://www.gnu.org/licenses/>.
+
+===========================================================================
+*/
+
+// sg_profiler.cpp -- per-frame timing of the server frame phases
+//
+// Every phase accumulates microseconds and call counts over a frame. At the end
+// of the frame the totals go into a ring of the last PROFILE_WINDOW frames from
+// which percentiles are computed on demand, and optionally into a log file.
+
+#include "sg_local.h"
+#include "sg_profiler.h"
+
+#define PROFILE_WINDOW 1024 // frames
+
+static Cvar::Cvar<bool> g_profile(
+	"g_profile", "record per-phase timings of every server frame", Cvar::NONE, false);
+static Cvar::Cvar<std::string> g_profileLog(
+	"g_profileLog", "file to log per-frame phase timings to, as CSV or as JSON lines if the name ends in .json", Cvar::NONE, "");
+
+static const char *const profilePhaseNames[ NUM_PROFILE_PHASES ] =
+{
+	"frame",
+	"entities",
+	"missiles",
+	"buildables",
+	"corpses",
+	"movers",
+	"physics",
+	"clients",
+	"botThink",
+	"think",
+	"thinkingComponents",
+	"clientThink",
+	"clientEndFrame",
+	"unlaggedStore",
+	"buildPoints",
+	"powerStates",
+	"momentum",
+	"spawnClients",
+	"zaps",
+	"beacons",
+	"netcode",
+	"botFill",
+	"teamStatus",
+	"botObstacles",
+};
+
+struct profilePhaseStats_t
+{
+	int64_t  current;       // microseconds in the frame being recorded
+	int      currentCalls;
+	uint32_t samples[ PROFILE_WINDOW ];
+	int64_t  totalCalls;    // calls over the frames in the window
+	int      calls[ PROFILE_WINDOW ];
+};
+
+static struct
+{
+	profilePhaseStats_t phases[ NUM_PROFILE_PHASES ];
+	int                 numFrames; // frames recorded, the newest is numFrames - 1
+
+	fileHandle_t        logFile;
+	std::string         logName;
+	bool                logJSON;
+} profiler;
+
+bool G_ProfileActive()
+{
+	return g_profile.Get() || profiler.logFile;
+}
+
+void G_ProfileAdd( profilePhase_t phase, Sys::SteadyClock::time_point start )
+{
+	auto elapsed = Sys::SteadyClock::now() - start;
+
+	profiler.phases[ phase ].current += std::chrono::duration_cast<std::chrono::microseconds>( elapsed ).count();
+	profiler.phases[ phase ].currentCalls++;
+}
+
+static void G_ProfileReset()
+{
+	memset( profiler.phases, 0, sizeof( profiler.phases ) );
+	profiler.numFrames = 0;
+}
+
+static void G_ProfileCloseLog()
+{
+	if ( profiler.logFile )
+	{
+		trap_FS_FCloseFile( profiler.logFile );
+		profiler.logFile = 0;
+	}
+
+	profiler.logName.clear();
+}
+
+/*
+================
+G_ProfileUpdateLog
+
+Opens or closes the log file when g_profileLog changes.
+================
+*/
+static void G_ProfileUpdateLog()
+{
+	const std::string &name = g_profileLog.Get();
+
+	if ( name == profiler.logName )
+	{
+		return;
+	}
+
+	G_ProfileCloseLog();
+	profiler.logName = name;
+
+	if ( name.empty() )
+	{
+		return;
+	}
+
+	trap_FS_FOpenFile( name.c_str(), &profiler.logFile, fsMode_t::FS_WRITE );
+
+	if ( !profiler.logFile )
+	{
+		Log::Warn( "Couldn't open profile log: %s", name );
+		return;
+	}
+
+	profiler.logJSON = name.size() >= 5 && !Q_stricmp( name.c_str() + name.size() - 5, ".json" );
+
+	if ( !profiler.logJSON )
+	{
+		std::string header = "frame,time";
+
+		for ( const char *phaseName : profilePhaseNames )
+		{
+			header += ',';
+			header += phaseName;
+		}
+
+		header += '\n';
+		trap_FS_Write( header.data(), header.size(), profiler.logFile );
+	}
+}
+
+static void G_ProfileWriteLog()
+{
+	std::string line;
+
+	if ( profiler.logJSON )
+	{
+		line = Str::Format( "{\"frame\":%d,\"time\":%d", level.framenum, level.time );
+
+		for ( int i = 0; i < NUM_PROFILE_PHASES; i++ )
+		{
+			line += Str::Format( ",\"%s\":%d", profilePhaseNames[ i ], ( int ) profiler.phases[ i ].current );
+		}
+
+		line += "}\n";
+	}
+	else
+	{
+		line = Str::Format( "%d,%d", level.framenum, level.time );
+
+		for ( int i = 0; i < NUM_PROFILE_PHASES; i++ )
+		{
+			line += Str::Format( ",%d", ( int ) profiler.phases[ i ].current );
+		}
+
+		line += '\n';
+	}
+
+	trap_FS_Write( line.data(), line.size(), profiler.logFile );
+}
+
+/*
+================
+G_ProfileEndFrame
+================
+*/
+void G_ProfileEndFrame()
+{
+	G_ProfileUpdateLog();
+
+	if ( !G_ProfileActive() )
+	{
+		return;
+	}
+
+	if ( profiler.logFile )
+	{
+		G_ProfileWriteLog();
+	}
+
+	int slot = profiler.numFrames % PROFILE_WINDOW;
+
+	for ( profilePhaseStats_t &phase : profiler.phases )
+	{
+		if ( profiler.numFrames >= PROFILE_WINDOW )
+		{
+			phase.totalCalls -= phase.calls[ slot ];
+		}
+
+		phase.samples[ slot ] = ( uint32_t ) phase.current;
+		phase.calls[ slot ] = phase.currentCalls;
+		phase.totalCalls += phase.currentCalls;
+		phase.current = 0;
+		phase.currentCalls = 0;
+	}
+
+	profiler.numFrames++;
+}
+
+void G_ProfileShutdown()
+{
+	G_ProfileCloseLog();
+}
+
+/*
+================
+G_Profile_f
+
+Prints the frame time percentiles of every phase over the last frames.
+================
+*/
+void G_Profile_f()
+{
+	char arg[ 8 ];
+
+	if ( trap_Argc() > 1 )
+	{
+		trap_Argv( 1, arg, sizeof( arg ) );
+
+		if ( !Q_stricmp( arg, "reset" ) )
+		{
+			G_ProfileReset();
+			return;
+		}
+
+		Log::Notice( "usage: profile [reset]" );
+		return;
+	}
+
+	int frames = std::min( profiler.numFrames, PROFILE_WINDOW );
+
+	if ( !frames )
+	{
+		Log::Notice( "no frames recorded, set g_profile 1 or g_profileLog first" );
+		return;
+	}
+
+	Log::Notice( "last %d frames, times in microseconds:", frames );
+	Log::Notice( "%-20s %8s %8s %8s %8s", "phase", "calls", "p50", "p99", "max" );
+
+	std::vector<uint32_t> samples( frames );
+
+	for ( int i = 0; i < NUM_PROFILE_PHASES; i++ )
+	{
+		const profilePhaseStats_t &phase = profiler.phases[ i ];
+
+		samples.assign( phase.samples, phase.samples + frames );
+
+		auto p50 = samples.begin() + ( frames - 1 ) / 2;
+		auto p99 = samples.begin() + ( frames - 1 ) * 99 / 100;
+		std::nth_element( samples.begin(), p99, samples.end() );
+		uint32_t p99Value = *p99;
+		std::nth_element( samples.begin(), p50, p99 );
+		uint32_t maxValue = *std::max_element( p99, samples.end() );
+
+		Log::Notice( "%-20s %8.1f %8u %8u %8u", profilePhaseNames[ i ],
+		             ( float ) phase.totalCalls / frames, *p50, p99Value, maxValue );
+	}
+}
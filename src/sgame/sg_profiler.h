@@ -0,0 +1,104 @@
+/*
+===========================================================================
+
+Unvanquished GPL Source Code
+Copyright (C) 2026 Unvanquished Developers
+
+This file is part of the Unvanquished GPL Source Code (Unvanquished Source Code).
+
+Unvanquished is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Unvanquished is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Unvanquished.  If not, see <http://www.gnu.org/licenses/>.
+
+===========================================================================
+*/
+
+// sg_profiler.h -- per-frame timing of the server frame phases
+
+#ifndef SG_PROFILER_H_
+#define SG_PROFILER_H_
+
+enum profilePhase_t
+{
+	PROFILE_FRAME,
+	PROFILE_ENTITIES,
+	PROFILE_MISSILES,
+	PROFILE_BUILDABLES,
+	PROFILE_CORPSES,
+	PROFILE_MOVERS,
+	PROFILE_PHYSICS,
+	PROFILE_CLIENTS,
+	PROFILE_BOT_THINK,
+	PROFILE_THINK,
+	PROFILE_THINKING_COMPONENTS,
+	PROFILE_CLIENT_THINK, // usercmds of human players, run between frames
+	PROFILE_CLIENT_END_FRAME,
+	PROFILE_UNLAGGED_STORE,
+	PROFILE_BUILD_POINTS,
+	PROFILE_POWER_STATES,
+	PROFILE_MOMENTUM,
+	PROFILE_SPAWN_CLIENTS,
+	PROFILE_ZAPS,
+	PROFILE_BEACONS,
+	PROFILE_NETCODE,
+	PROFILE_BOT_FILL,
+	PROFILE_TEAM_STATUS,
+	PROFILE_BOT_OBSTACLES,
+
+	NUM_PROFILE_PHASES
+};
+
+bool G_ProfileActive();
+void G_ProfileAdd( profilePhase_t phase, Sys::SteadyClock::time_point start );
+
+// called at the end of G_RunFrame to commit the timings of the frame
+void G_ProfileEndFrame();
+void G_ProfileShutdown();
+void G_Profile_f();
+
+/*
+ * Adds the time spent until the end of the scope to a phase.
+ * A phase may be entered several times per frame, the times add up.
+ */
+class G_ProfileScope
+{
+public:
+	G_ProfileScope( profilePhase_t phase ) : phase( phase ), active( G_ProfileActive() )
+	{
+		if ( active )
+		{
+			start = Sys::SteadyClock::now();
+		}
+	}
+
+	~G_ProfileScope()
+	{
+		Stop();
+	}
+
+	// ends the measurement before the end of the scope
+	void Stop()
+	{
+		if ( active )
+		{
+			G_ProfileAdd( phase, start );
+			active = false;
+		}
+	}
+
+private:
+	profilePhase_t                phase;
+	bool                          active;
+	Sys::SteadyClock::time_point start;
+};
+
+#endif // SG_PROFILER_H_
@@ -177,6 +177,7 @@ struct fieldDescriptor_t
 	fieldType_t type;
 	int   versionState;
 	const char  *replacement;
+	bool  script; // offset is into gentityScript_t instead of gentity_t
 };
 
 static const fieldDescriptor_t fields[] =
@@ -198,16 +199,16 @@ static const fieldDescriptor_t fields[] =
 	{ "model2",              FOFS( model2 ),              F_STRING    ,ENT_V_UNCLEAR, nullptr },
 	{ "name",	        	 FOFS( names[ 0 ] ),          F_STRING	  ,ENT_V_UNCLEAR, nullptr },
 	{ "noise",               FOFS( soundIndex ),          F_SOUNDINDEX,ENT_V_UNCLEAR, nullptr },
-	{ "onAct",               FOFS( calltargets ),         F_CALLTARGET,ENT_V_UNCLEAR, nullptr },
-	{ "onDie",               FOFS( calltargets ),         F_CALLTARGET,ENT_V_UNCLEAR, nullptr },
-	{ "onDisable",           FOFS( calltargets ),         F_CALLTARGET,ENT_V_UNCLEAR, nullptr },
-	{ "onEnable",            FOFS( calltargets ),         F_CALLTARGET,ENT_V_UNCLEAR, nullptr },
-	{ "onFree",              FOFS( calltargets ),         F_CALLTARGET,ENT_V_UNCLEAR, nullptr },
-	{ "onReach",             FOFS( calltargets ),         F_CALLTARGET,ENT_V_UNCLEAR, nullptr },
-	{ "onReset",             FOFS( calltargets ),         F_CALLTARGET,ENT_V_UNCLEAR, nullptr },
-	{ "onSpawn",             FOFS( calltargets ),         F_CALLTARGET,ENT_V_UNCLEAR, nullptr },
-	{ "onTouch",             FOFS( calltargets ),         F_CALLTARGET,ENT_V_UNCLEAR, nullptr },
-	{ "onUse",               FOFS( calltargets ),         F_CALLTARGET,ENT_V_UNCLEAR, nullptr },
+	{ "onAct",               SOFS( calltargets ),         F_CALLTARGET,ENT_V_UNCLEAR, nullptr, true },
+	{ "onDie",               SOFS( calltargets ),         F_CALLTARGET,ENT_V_UNCLEAR, nullptr, true },
+	{ "onDisable",           SOFS( calltargets ),         F_CALLTARGET,ENT_V_UNCLEAR, nullptr, true },
+	{ "onEnable",            SOFS( calltargets ),         F_CALLTARGET,ENT_V_UNCLEAR, nullptr, true },
+	{ "onFree",              SOFS( calltargets ),         F_CALLTARGET,ENT_V_UNCLEAR, nullptr, true },
+	{ "onReach",             SOFS( calltargets ),         F_CALLTARGET,ENT_V_UNCLEAR, nullptr, true },
+	{ "onReset",             SOFS( calltargets ),         F_CALLTARGET,ENT_V_UNCLEAR, nullptr, true },
+	{ "onSpawn",             SOFS( calltargets ),         F_CALLTARGET,ENT_V_UNCLEAR, nullptr, true },
+	{ "onTouch",             SOFS( calltargets ),         F_CALLTARGET,ENT_V_UNCLEAR, nullptr, true },
+	{ "onUse",               SOFS( calltargets ),         F_CALLTARGET,ENT_V_UNCLEAR, nullptr, true },
 	{ "origin",              FOFS( s.origin ),            F_3D_VECTOR ,ENT_V_UNCLEAR, nullptr },
 	{ "period",              FOFS( config.period ),       F_TIME      ,ENT_V_UNCLEAR, nullptr },
 	{ "radius",              FOFS( activatedPosition ),   F_3D_VECTOR ,ENT_V_UNCLEAR, nullptr }, // What's with the variable abuse everytime?
@@ -220,7 +221,7 @@ static const fieldDescriptor_t fields[] =
 	{ "soundPos2",           FOFS( soundPos2 ),           F_SOUNDINDEX,ENT_V_UNCLEAR, nullptr },
 	{ "spawnflags",          FOFS( spawnflags ),          F_INT       ,ENT_V_UNCLEAR, nullptr },
 	{ "speed",               FOFS( config.speed ),        F_FLOAT     ,ENT_V_UNCLEAR, nullptr },
-	{ "stage",               FOFS( conditions.stage ),    F_INT       ,ENT_V_UNCLEAR, nullptr },
+	{ "stage",               SOFS( conditions.stage ),    F_INT       ,ENT_V_UNCLEAR, nullptr, true },
 	{ "target",              FOFS( targets ),             F_TARGET    ,ENT_V_UNCLEAR, nullptr },
 	{ "target2",             FOFS( targets ),             F_TARGET    ,ENT_V_UNCLEAR, nullptr }, // backwardcompatibility with AMP and to use the blackout map for testing
 	{ "target3",             FOFS( targets ),             F_TARGET    ,ENT_V_UNCLEAR, nullptr }, // backwardcompatibility with AMP and to use the blackout map for testing
@@ -229,7 +230,7 @@ static const fieldDescriptor_t fields[] =
 	{ "targetname2",         FOFS( names[ 2 ] ),          F_STRING,    ENT_V_RENAMED, "name" }, // backwardcompatibility with AMP and to use the blackout map for testing
 	{ "targetShaderName",    FOFS( shaderKey ),           F_STRING,    ENT_V_RENAMED, "shader"},
 	{ "targetShaderNewName", FOFS( shaderReplacement ),   F_STRING,    ENT_V_RENAMED, "replacement"},
-	{ "team",                FOFS( conditions.team ),     F_INT       ,ENT_V_UNCLEAR, nullptr },
+	{ "team",                SOFS( conditions.team ),     F_INT       ,ENT_V_UNCLEAR, nullptr, true },
 	{ "wait",                FOFS( config.wait ),         F_TIME      ,ENT_V_UNCLEAR, nullptr },
 	{ "yaw",                 FOFS( s.angles ),            F_YAW       ,ENT_V_UNCLEAR, nullptr },
 };
@@ -479,7 +480,7 @@ bool G_ValidateEntity( entityClassDescriptor_t *entityClass, gentity_t *entity )
 {
 	switch (entityClass->chainType) {
 		case CHAIN_ACTIVE:
-			if(!entity->callTargetCount) //check target usage for backward compatibility
+			if(!entity->script || !entity->script->callTargetCount) //check target usage for backward compatibility
 			{
 				if( g_debugEntities.integer > -2 )
 					Log::Warn("Entity %s needs to call or target to something — Removing it.", etos( entity ) );
@@ -496,7 +497,7 @@ bool G_ValidateEntity( entityClassDescriptor_t *entityClass, gentity_t *entity )
 			}
 			break;
 		case CHAIN_RELAY:
-			if((!entity->callTargetCount) //check target usage for backward compatibility
+			if((!entity->script || !entity->script->callTargetCount) //check target usage for backward compatibility
 					|| !entity->names[0])
 			{
 				if( g_debugEntities.integer > -2 )
@@ -704,7 +705,14 @@ void G_ParseField( const char *key, const char *rawString, gentity_t *entity )
 		return;
 	}
 
-	entityDataField = ( byte * ) entity + fieldDescriptor->offset;
+	if ( fieldDescriptor->script )
+	{
+		entityDataField = ( byte * ) G_ScriptData( entity ) + fieldDescriptor->offset;
+	}
+	else
+	{
+		entityDataField = ( byte * ) entity + fieldDescriptor->offset;
+	}
 
 	switch ( fieldDescriptor->type )
 	{
@@ -720,10 +728,10 @@ void G_ParseField( const char *key, const char *rawString, gentity_t *entity )
 			break;
 
 		case F_CALLTARGET:
-			if(entity->callTargetCount >= MAX_ENTITY_CALLTARGETS)
+			if(entity->script->callTargetCount >= MAX_ENTITY_CALLTARGETS)
 				Sys::Drop("Maximal number of %i calltargets reached. You can solve this by using a Relay.", MAX_ENTITY_CALLTARGETS);
 
-			( ( gentityCallDefinition_t * ) entityDataField ) [ entity->callTargetCount++ ] = G_NewCallDefinition( fieldDescriptor->replacement ? fieldDescriptor->replacement : fieldDescriptor->name, rawString );
+			( ( gentityCallDefinition_t * ) entityDataField ) [ entity->script->callTargetCount++ ] = G_NewCallDefinition( fieldDescriptor->replacement ? fieldDescriptor->replacement : fieldDescriptor->name, rawString );
 			break;
 
 		case F_TIME:
@@ -837,18 +845,20 @@ void G_SpawnGEntityFromSpawnVars()
 	 * for backward compatbility, since before targets were used for calling,
 	 * we'll have to copy them over to the called-targets as well for now
 	 */
-	if(!spawningEntity->callTargetCount)
+	if(spawningEntity->targetCount && (!spawningEntity->script || !spawningEntity->script->callTargetCount))
 	{
+		gentityScript_t *script = G_ScriptData( spawningEntity );
+
 		for (i = 0; i < MAX_ENTITY_TARGETS && i < MAX_ENTITY_CALLTARGETS; i++)
 		{
 			if (!spawningEntity->targets[i])
 				continue;
 
-			spawningEntity->calltargets[i].event = "target";
-			spawningEntity->calltargets[i].eventType = ON_DEFAULT;
-			spawningEntity->calltargets[i].actionType = ECA_DEFAULT;
-			spawningEntity->calltargets[i].name = spawningEntity->targets[i];
-			spawningEntity->callTargetCount++;
+			script->calltargets[i].event = "target";
+			script->calltargets[i].eventType = ON_DEFAULT;
+			script->calltargets[i].actionType = ECA_DEFAULT;
+			script->calltargets[i].name = spawningEntity->targets[i];
+			script->callTargetCount++;
 		}
 	}
 
@@ -871,20 +881,27 @@ void G_SpawnGEntityFromSpawnVars()
 void G_ReorderCallTargets( gentity_t *ent )
 {
 	int i, j;
+	gentityCallDefinition_t *calltargets;
+
+	if ( !ent->script )
+		return;
+
+	calltargets = ent->script->calltargets;
+
 	// don't leave any "gaps" between multiple targets
 	j = 0;
 	for (i = 0; i < MAX_ENTITY_CALLTARGETS; ++i)
 	{
-		if (ent->calltargets[i].name) {
-			ent->calltargets[j] = ent->calltargets[i];
-			ent->calltargets[j].actionType = G_GetCallActionTypeFor(ent->calltargets[i].action);
+		if (calltargets[i].name) {
+			calltargets[j] = calltargets[i];
+			calltargets[j].actionType = G_GetCallActionTypeFor(calltargets[i].action);
 			j++;
 		}
 	}
-	ent->calltargets[ j ].name = nullptr;
-	ent->calltargets[ j ].action = nullptr;
-	ent->calltargets[ j ].actionType = ECA_NOP;
-	ent->callTargetCount = j;
+	calltargets[ j ].name = nullptr;
+	calltargets[ j ].action = nullptr;
+	calltargets[ j ].actionType = ECA_NOP;
+	ent->script->callTargetCount = j;
 }
 
 bool G_WarnAboutDeprecatedEntityField( gentity_t *entity, const char *expectedFieldname, const char *actualFieldname, const int typeOfDeprecation  )
@@ -82,7 +82,7 @@ void game_end_act( gentity_t *self, gentity_t*, gentity_t* )
 {
 	if ( level.unconditionalWin == TEAM_NONE ) // only if not yet triggered
 	{
-		level.unconditionalWin = self->conditions.team;
+		level.unconditionalWin = G_ScriptData( self )->conditions.team;
 	}
 }
 
@@ -90,11 +90,11 @@ void SP_game_end( gentity_t *self )
 {
 	if(!Q_stricmp(self->classname, "target_human_win"))
 	{
-		self->conditions.team = TEAM_HUMANS;
+		G_ScriptData( self )->conditions.team = TEAM_HUMANS;
 	}
 	else if(!Q_stricmp(self->classname, "target_alien_win"))
 	{
-		self->conditions.team = TEAM_ALIENS;
+		G_ScriptData( self )->conditions.team = TEAM_ALIENS;
 	}
 
 	self->act = game_end_act;
@@ -63,7 +63,7 @@ void sensor_reset( gentity_t *self )
 	self->enabled = !(self->spawnflags & SPF_SPAWN_DISABLED);
 
 	// NEGATE?
-	self->conditions.negated = !!( self->spawnflags & 2 );
+	G_ScriptData( self )->conditions.negated = !!( self->spawnflags & 2 );
 }
 
 //some old sensors/triggers used to propagate use-events, this is deprecated behavior
@@ -113,8 +113,10 @@ void trigger_multiple_act( gentity_t *self, gentity_t*, gentity_t *activator )
 	if ( self->nextthink )
 		return; // can't retrigger until the wait is over
 
-	if ( activator && activator->client && self->conditions.team &&
-	   ( activator->client->pers.team != self->conditions.team ) )
+	team_t team = G_ScriptData( self )->conditions.team;
+
+	if ( activator && activator->client && team &&
+	   ( activator->client->pers.team != team ) )
 		return;
 
 	G_FireEntity( self, self->activator );
@@ -131,9 +133,9 @@ void trigger_multiple_compat_reset( gentity_t *self )
 	if (!!( self->spawnflags & 1 ) != !!( self->spawnflags & 2 )) //if both are set or none are set we assume TEAM_ALL
 	{
 		if ( self->spawnflags & 1 )
-			self->conditions.team = TEAM_HUMANS;
+			G_ScriptData( self )->conditions.team = TEAM_HUMANS;
 		else if ( self->spawnflags & 2 )
-			self->conditions.team = TEAM_ALIENS;
+			G_ScriptData( self )->conditions.team = TEAM_ALIENS;
 	}
 
 	if ( self->spawnflags && g_debugEntities.integer >= -1 ) //dont't warn about anything with -1 or lower
@@ -248,9 +250,11 @@ void G_notify_sensor_stage( team_t team, int previousStage, int newStage )
 
 	while ((entities = G_IterateEntitiesOfClass(entities, S_SENSOR_STAGE)) != nullptr )
 	{
-		if (((!entities->conditions.stage || newStage == entities->conditions.stage)
-				&& (!entities->conditions.team || team == entities->conditions.team))
-				== !entities->conditions.negated)
+		const gentityConditions_t &conditions = G_ScriptData( entities )->conditions;
+
+		if (((!conditions.stage || newStage == conditions.stage)
+				&& (!conditions.team || team == conditions.team))
+				== !conditions.negated)
 		{
 			G_FireEntity(entities, entities);
 		}
@@ -286,7 +290,9 @@ void G_notify_sensor_end( team_t winningTeam )
 
 	while ((entity = G_IterateEntitiesOfClass(entity, S_SENSOR_END)) != nullptr )
 	{
-		if ((winningTeam == entity->conditions.team) == !entity->conditions.negated)
+		const gentityConditions_t &conditions = G_ScriptData( entity )->conditions;
+
+		if ((winningTeam == conditions.team) == !conditions.negated)
 			G_FireEntity(entity, entity);
 	}
 }
@@ -315,6 +321,7 @@ sensor_buildable
 bool sensor_buildable_match( gentity_t *self, gentity_t *activator )
 {
 	int i = 0;
+	const gentityConditions_t &conditions = G_ScriptData( self )->conditions;
 
 	if ( !activator )
 	{
@@ -322,16 +329,16 @@ bool sensor_buildable_match( gentity_t *self, gentity_t *activator )
 	}
 
 	//if there is no buildable list every buildable triggers
-	if ( self->conditions.buildables[ i ] == BA_NONE )
+	if ( conditions.buildables[ i ] == BA_NONE )
 	{
 		return true;
 	}
 	else
 	{
 		//otherwise check against the list
-		for ( i = 0; self->conditions.buildables[ i ] != BA_NONE; i++ )
+		for ( i = 0; conditions.buildables[ i ] != BA_NONE; i++ )
 		{
-			if ( activator->s.modelindex == self->conditions.buildables[ i ] )
+			if ( activator->s.modelindex == conditions.buildables[ i ] )
 			{
 				return true;
 			}
@@ -356,7 +363,7 @@ void sensor_buildable_touch( gentity_t *self, gentity_t *activator, trace_t* )
 		return; // can't retrigger until the wait is over
 	}
 
-	if( sensor_buildable_match( self, activator ) == !self->conditions.negated )
+	if( sensor_buildable_match( self, activator ) == !G_ScriptData( self )->conditions.negated )
 	{
 		G_FireEntity( self, activator );
 		trigger_checkWaitForReactivation( self );
@@ -391,6 +398,7 @@ sensor_class_match
 bool sensor_class_match( gentity_t *self, gentity_t *activator )
 {
 	int i = 0;
+	const gentityConditions_t &conditions = G_ScriptData( self )->conditions;
 
 	if ( !activator )
 	{
@@ -398,16 +406,16 @@ bool sensor_class_match( gentity_t *self, gentity_t *activator )
 	}
 
 	//if there is no class list every class triggers (stupid case)
-	if ( self->conditions.classes[ i ] == PCL_NONE )
+	if ( conditions.classes[ i ] == PCL_NONE )
 	{
 		return true;
 	}
 	else
 	{
 		//otherwise check against the list
-		for ( i = 0; self->conditions.classes[ i ] != PCL_NONE; i++ )
+		for ( i = 0; conditions.classes[ i ] != PCL_NONE; i++ )
 		{
-			if ( activator->client->ps.stats[ STAT_CLASS ] == self->conditions.classes[ i ] )
+			if ( activator->client->ps.stats[ STAT_CLASS ] == conditions.classes[ i ] )
 			{
 				return true;
 			}
@@ -425,13 +433,14 @@ sensor_equipment_match
 bool sensor_equipment_match( gentity_t *self, gentity_t *activator )
 {
 	int i = 0;
+	const gentityConditions_t &conditions = G_ScriptData( self )->conditions;
 
 	if ( !activator )
 	{
 		return false;
 	}
 
-	if ( self->conditions.weapons[ i ] == WP_NONE && self->conditions.upgrades[ i ] == UP_NONE )
+	if ( conditions.weapons[ i ] == WP_NONE && conditions.upgrades[ i ] == UP_NONE )
 	{
 		//if there is no equipment list all equipment triggers for the old behavior of target_equipment, but not the new or different one
 		return true;
@@ -439,17 +448,17 @@ bool sensor_equipment_match( gentity_t *self, gentity_t *activator )
 	else
 	{
 		//otherwise check against the lists
-		for ( i = 0; self->conditions.weapons[ i ] != WP_NONE; i++ )
+		for ( i = 0; conditions.weapons[ i ] != WP_NONE; i++ )
 		{
-			if ( BG_InventoryContainsWeapon( self->conditions.weapons[ i ], activator->client->ps.stats ) )
+			if ( BG_InventoryContainsWeapon( conditions.weapons[ i ], activator->client->ps.stats ) )
 			{
 				return true;
 			}
 		}
 
-		for ( i = 0; self->conditions.upgrades[ i ] != UP_NONE; i++ )
+		for ( i = 0; conditions.upgrades[ i ] != UP_NONE; i++ )
 		{
-			if ( BG_InventoryContainsUpgrade( self->conditions.upgrades[ i ], activator->client->ps.stats ) )
+			if ( BG_InventoryContainsUpgrade( conditions.upgrades[ i ], activator->client->ps.stats ) )
 			{
 				return true;
 			}
@@ -462,6 +471,7 @@ bool sensor_equipment_match( gentity_t *self, gentity_t *activator )
 void sensor_player_touch( gentity_t *self, gentity_t *activator, trace_t* )
 {
 	bool shouldFire;
+	const gentityConditions_t &conditions = G_ScriptData( self )->conditions;
 
 	//sanity check
 	if ( !activator || !activator->client )
@@ -476,14 +486,14 @@ void sensor_player_touch( gentity_t *self, gentity_t *activator, trace_t* )
 		return; // can't retrigger until the wait is over
 	}
 
-	if ( self->conditions.team && ( activator->client->pers.team != self->conditions.team ) )
+	if ( conditions.team && ( activator->client->pers.team != conditions.team ) )
 		return;
 
-	if ( ( self->conditions.upgrades[0] || self->conditions.weapons[0] ) && activator->client->pers.team == TEAM_HUMANS )
+	if ( ( conditions.upgrades[0] || conditions.weapons[0] ) && activator->client->pers.team == TEAM_HUMANS )
 	{
 		shouldFire = sensor_equipment_match( self, activator );
 	}
-	else if ( self->conditions.classes[0] && activator->client->pers.team == TEAM_ALIENS )
+	else if ( conditions.classes[0] && activator->client->pers.team == TEAM_ALIENS )
 	{
 		shouldFire = sensor_class_match( self, activator );
 	}
@@ -492,7 +502,7 @@ void sensor_player_touch( gentity_t *self, gentity_t *activator, trace_t* )
 		shouldFire = true;
 	}
 
-	if( shouldFire == !self->conditions.negated )
+	if( shouldFire == !conditions.negated )
 	{
 		G_FireEntity( self, activator );
 		trigger_checkWaitForReactivation( self );
@@ -534,7 +544,7 @@ void sensor_support_think( gentity_t *self )
 		return;
 	}
 
-	switch (self->conditions.team) {
+	switch (G_ScriptData( self )->conditions.team) {
 		case TEAM_HUMANS:
 			self->powered = (G_ActiveReactor() != nullptr);
 			break;
@@ -200,16 +200,17 @@ shared field spawn functions
 
 void SP_ConditionFields( gentity_t *self ) {
 	char *buffer;
+	gentityConditions_t *conditions = &G_ScriptData( self )->conditions;
 
 	if ( G_SpawnString( "buildables", "", &buffer ) )
-		BG_ParseCSVBuildableList( buffer, self->conditions.buildables, BA_NUM_BUILDABLES );
+		BG_ParseCSVBuildableList( buffer, conditions->buildables, BA_NUM_BUILDABLES );
 
 	if ( G_SpawnString( "classes", "", &buffer ) )
-		BG_ParseCSVClassList( buffer, self->conditions.classes, PCL_NUM_CLASSES );
+		BG_ParseCSVClassList( buffer, conditions->classes, PCL_NUM_CLASSES );
 
 	if ( G_SpawnString( "equipment", "", &buffer ) )
-		BG_ParseCSVEquipmentList( buffer, self->conditions.weapons, WP_NUM_WEAPONS,
-	                          self->conditions.upgrades, UP_NUM_UPGRADES );
+		BG_ParseCSVEquipmentList( buffer, conditions->weapons, WP_NUM_WEAPONS,
+	                          conditions->upgrades, UP_NUM_UPGRADES );
 
 }
 
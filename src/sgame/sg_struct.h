@@ -88,6 +88,56 @@ struct entityClass_s
 	gentityConfig_t config;
 };
 
+/**
+ * map scripting data of a gentity
+ * only entities that call others or filter by conditions have it, see G_ScriptData
+ */
+struct gentityScript_s
+{
+	/*
+	 * gentities to call on certain events
+	 */
+	int          callTargetCount;
+	gentityCallDefinition_t calltargets[ MAX_ENTITY_CALLTARGETS + 1 ];
+
+	//conditions as trigger-filter or target-goal
+	gentityConditions_t conditions;
+};
+
+/**
+ * damage a client dealt to an entity, to reward the attackers once it dies
+ */
+struct damageCredit_s
+{
+	int    clientNum;
+	float  value;
+	int    time;
+	team_t team;
+};
+
+/**
+ * the damage credits of an entity, at most one per client
+ * usually only a few clients damage an entity, so the first credits are kept
+ * inline and only more than that spill over into extra, see G_AddDamageCredit
+ */
+struct damageLedger_s
+{
+	int            numCredits;
+	int            extraSize; // number of credits extra has room for
+	damageCredit_t credits[ DAMAGE_LEDGER_INLINE ];
+	damageCredit_t *extra;
+
+	damageCredit_t &operator[]( int index )
+	{
+		return index < DAMAGE_LEDGER_INLINE ? credits[ index ] : extra[ index - DAMAGE_LEDGER_INLINE ];
+	}
+
+	const damageCredit_t &operator[]( int index ) const
+	{
+		return index < DAMAGE_LEDGER_INLINE ? credits[ index ] : extra[ index - DAMAGE_LEDGER_INLINE ];
+	}
+};
+
 class Entity;
 
 // Replacement for gentity_t* that can detect the case where an entity has been recycled.
@@ -100,7 +150,7 @@ struct GentityRef
 
 	GentityRef& operator=(struct gentity_s *ent);
 
-	operator bool();
+	operator bool() const;
 
 	struct gentity_s * operator->()
 	{
@@ -120,6 +170,11 @@ struct gentity_s
 	// New style entity
 	Entity* entity;
 
+	/*
+	 * what the loop over all entities in G_RunFrame looks at every frame, keep it
+	 * together here and put anything that is rarely used further down, or into
+	 * gentityScript_t if it only matters to map scripting
+	 */
 	struct gclient_s *client; // nullptr if not a client
 
 	unsigned generation; // used with GentityRef
@@ -128,6 +183,13 @@ struct gentity_s
 	bool     inuse;
 	bool     freeAfterEvent;
 	bool     unlinkAfterEvent;
+	bool     evaluateAcceleration;
+
+	bool physicsObject; // if true, it can be pushed by movers and fall off edges
+	// all game items are physicsObjects,
+
+	int       nextthink;
+	void ( *think )( gentity_t *self );
 
 	int          flags; // FL_* variables
 
@@ -208,10 +270,10 @@ struct gentity_s
 	gentity_t    *nextPathSegment;
 
 	/*
-	 * gentities to call on certain events
+	 * gentities to call on certain events and conditions,
+	 * nullptr unless the entity was spawned with any
 	 */
-	int          callTargetCount;
-	gentityCallDefinition_t calltargets[ MAX_ENTITY_CALLTARGETS + 1 ];
+	gentityScript_t *script;
 
 	/**
 	 * current valid call state for a single threaded call hierarchy.
@@ -227,9 +289,6 @@ struct gentity_s
 	 */
 	gentityConfig_t config;
 
-	//conditions as trigger-filter or target-goal
-	gentityConditions_t conditions;
-
 	// entity groups
 	char         *groupName;
 	gentity_t    *groupChain; // next entity in group
@@ -238,8 +297,6 @@ struct gentity_s
 	char     *model;
 	char     *model2;
 
-	bool physicsObject; // if true, it can be pushed by movers and fall off edges
-	// all game items are physicsObjects,
 	float    physicsBounce; // 1.0 = continuous bounce, 0.0 = no bounce
 	int      clipmask; // brushes with this content value will be collided against
 	// when moving.  items and corpses do not collide against
@@ -283,7 +340,6 @@ struct gentity_s
 	int count;
 
 	// acceleration evaluation
-	bool  evaluateAcceleration;
 	vec3_t    oldVelocity;
 	vec3_t    acceleration;
 	vec3_t    oldAccel;
@@ -291,9 +347,6 @@ struct gentity_s
 
 	vec3_t       movedir;
 
-	int       nextthink;
-	void ( *think )( gentity_t *self );
-
 	void ( *reset )( gentity_t *self );
 	void ( *reached )( gentity_t *self );       // movers call this when hitting endpoint
 	void ( *blocked )( gentity_t *self, gentity_t *other );
@@ -344,11 +397,7 @@ struct gentity_s
 	// every single frame.. so only do it periodically
 	int         clientSpawnTime; // the time until this spawn can spawn a client
 
-	struct {
-	 	float  value;
-		int    time;
-		team_t team;
-	}           credits[ MAX_CLIENTS ];
+	damageLedger_t damageLedger; // damage dealt by clients since the last reward
 
 	int         killedBy; // clientNum of killer
 
@@ -386,7 +435,7 @@ inline GentityRef& GentityRef::operator=(struct gentity_s *ent)
 	return *this;
 }
 
-inline GentityRef::operator bool()
+inline GentityRef::operator bool() const
 {
 	return entity != nullptr && entity->generation == generation;
 }
@@ -503,10 +552,20 @@ struct unlagged_s
 	vec3_t   origin;
 	vec3_t   mins;
 	vec3_t   maxs;
+	float    radius; // largest distance from origin to the box corners, set in unlaggedCalc
 	bool used;
 };
 
 #define MAX_UNLAGGED_MARKERS 256
+
+// the positions of all clients at a server frame
+struct unlaggedFrame_s
+{
+	vec3_t origin[ MAX_CLIENTS ];
+	vec3_t mins[ MAX_CLIENTS ];
+	vec3_t maxs[ MAX_CLIENTS ];
+	bool   used[ MAX_CLIENTS ];
+};
 #define MAX_TRAMPLE_BUILDABLES_TRACKED 20
 
 /**
@@ -569,7 +628,6 @@ struct gclient_s
 	int        lastAmmoRefillTime;
 	int        lastFuelRefillTime;
 
-	unlagged_t unlaggedHist[ MAX_UNLAGGED_MARKERS ];
 	unlagged_t unlaggedBackup;
 	unlagged_t unlaggedCalc;
 	int        unlaggedTime;
@@ -709,8 +767,14 @@ struct level_locals_s
 
 	int              pausedTime;
 
-	int              unlaggedIndex;
+	int              unlaggedIndex; // newest frame of the history
+	int              unlaggedCount; // frames stored in the history
 	int              unlaggedTimes[ MAX_UNLAGGED_MARKERS ];
+	unlaggedFrame_t  unlaggedFrames[ MAX_UNLAGGED_MARKERS ];
+	int              unlaggedCalcClients[ MAX_CLIENTS ]; // clients with unlaggedCalc.used
+	int              numUnlaggedCalcClients;
+	int              unlaggedMovedClients[ MAX_CLIENTS ]; // clients moved by G_UnlaggedOn
+	int              numUnlaggedMovedClients;
 
 	char             layout[ MAX_QPATH ];
 
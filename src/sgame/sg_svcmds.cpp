@@ -35,6 +35,9 @@ Maryland 20850 USA.
 // this file holds commands that can be executed by the server console, but not remote clients
 
 #include "sg_local.h"
+#include "sg_cm_world.h"
+#include "sg_profiler.h"
+#include "sg_pmovereplay.h"
 
 #define IS_NON_NULL_VEC3(vec3tor) (vec3tor[0] || vec3tor[1] || vec3tor[2])
 
@@ -175,8 +178,10 @@ void Svcmd_EntityShow_f()
 		Log::Notice( "");
 	}
 
-	if(selection->callTargetCount)
+	if(selection->script && selection->script->callTargetCount)
 	{
+		gentityCallDefinition_t *calltargets = selection->script->calltargets;
+
 		lastTargetIndex = -1;
 		while ((possibleTarget = G_IterateCallEndpoints(possibleTarget, &targetIndex, selection)) != nullptr )
 		{
@@ -184,16 +189,16 @@ void Svcmd_EntityShow_f()
 			if(lastTargetIndex != targetIndex)
 			{
 				Log::Notice("Calls %s \"%s:%s\"",
-						selection->calltargets[ targetIndex ].event ? selection->calltargets[ targetIndex ].event : "onUnknown",
-						selection->calltargets[ targetIndex ].name,
-						selection->calltargets[ targetIndex ].action ? selection->calltargets[ targetIndex ].action : "default");
+						calltargets[ targetIndex ].event ? calltargets[ targetIndex ].event : "onUnknown",
+						calltargets[ targetIndex ].name,
+						calltargets[ targetIndex ].action ? calltargets[ targetIndex ].action : "default");
 				lastTargetIndex = targetIndex;
 			}
 
 			Log::Notice(" • %s", etos(possibleTarget));
 			if(possibleTarget->names[1])
 			{
-				Log::Notice(" using \"%s\" ∈ ", selection->calltargets[ targetIndex ].name);
+				Log::Notice(" using \"%s\" ∈ ", calltargets[ targetIndex ].name);
 				G_PrintEntityNameList( possibleTarget );
 			}
 			Log::Notice("");
@@ -691,7 +696,9 @@ static const struct svcmd
 	{ "admitDefeat",        false, Svcmd_AdmitDefeat_f          },
 	{ "advanceMapRotation", false, Svcmd_G_AdvanceMapRotation_f },
 	{ "alienWin",           false, Svcmd_TeamWin_f              },
+	{ "allocStats",         false, BG_PrintAllocStats           },
 	{ "asay",               true,  Svcmd_MessageWrapper         },
+	{ "botTreeBenchmark",   false, G_BotTreeBenchmark_f         },
 	{ "chat",               true,  Svcmd_MessageWrapper         },
 	{ "cp",                 true,  Svcmd_CenterPrint_f          },
 	{ "dumpuser",           false, Svcmd_DumpUser_f             },
@@ -699,6 +706,7 @@ static const struct svcmd
 	{ "entityFire",         false, Svcmd_EntityFire_f           },
 	{ "entityList",         false, Svcmd_EntityList_f           },
 	{ "entityShow",         false, Svcmd_EntityShow_f           },
+	{ "entityStats",        false, G_EntityStats_f              },
 	{ "evacuation",         false, Svcmd_Evacuation_f           },
 	{ "forceTeam",          false, Svcmd_ForceTeam_f            },
 	{ "humanWin",           false, Svcmd_TeamWin_f              },
@@ -707,10 +715,13 @@ static const struct svcmd
 	{ "m",                  true,  Svcmd_MessageWrapper         },
 	{ "maplog",             true,  Svcmd_MapLogWrapper          },
 	{ "mapRotation",        false, Svcmd_MapRotation_f          },
+	{ "pmoveReplay",        false, G_PmoveReplay_f              },
 	{ "pr",                 false, Svcmd_Pr_f                   },
 	{ "printqueue",         false, Svcmd_PrintQueue_f           },
+	{ "profile",            false, G_Profile_f                  },
 	{ "say",                true,  Svcmd_MessageWrapper         },
 	{ "say_team",           true,  Svcmd_TeamMessage_f          },
+	{ "sectorList",         false, G_CM_SectorList_f            },
 	{ "stopMapRotation",    false, G_StopMapRotation            },
 };
 
@@ -0,0 +1,133 @@
+/*
+===========================================================================
+
+Unvanquished GPL Source Code
+Copyright (C) 2026 Unvanquished Developers
+
+This file is part of the Unvanquished GPL Source Code (Unvanquished Source Code).
+
+Unvanquished is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Unvanquished is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Unvanquished.  If not, see <http://www.gnu.org/licenses/>.
+
+===========================================================================
+*/
+
+// sg_targets.cpp -- per-frame index of the entities defensive buildables can attack
+//
+// Turrets, rocketpods and spikers all look for enemies every time they think.
+// Rather than having each of them walk all entities, the first one to ask in a
+// frame collects the candidates of both teams and the others reuse that list.
+
+#include "sg_local.h"
+#include "CBSE.h"
+#include "sg_targets.h"
+
+static struct
+{
+	int                            time = -1;
+	std::vector<targetCandidate_t> candidates[ NUM_TEAMS ];
+} targetIndex;
+
+/*
+================
+G_BuildTargetIndex
+================
+*/
+static void G_BuildTargetIndex()
+{
+	float frameSeconds = std::max( level.time - level.previousTime, 0 ) * 0.001f;
+
+	for ( std::vector<targetCandidate_t> &candidates : targetIndex.candidates )
+	{
+		candidates.clear();
+	}
+
+	ForEntities<HealthComponent>( [&]( Entity &entity, HealthComponent &healthComponent ) {
+		gentity_t *ent = entity.oldEnt;
+		team_t    team = G_Team( ent );
+		int       kind;
+		Vec3      velocity;
+
+		if ( team <= TEAM_NONE || team >= NUM_TEAMS )  return;
+		if ( !healthComponent.Alive() )                return;
+		if ( entity.Get<SpectatorComponent>() )        return;
+
+		if ( entity.Get<ClientComponent>() )
+		{
+			kind = TARGET_PLAYERS;
+			velocity = Vec3::Load( ent->client->ps.velocity );
+		}
+		else if ( entity.Get<BuildableComponent>() )
+		{
+			kind = TARGET_BUILDABLES;
+			velocity = Vec3::Load( ent->s.pos.trDelta );
+		}
+		else
+		{
+			return;
+		}
+
+		if ( ent->flags & FL_NOTARGET )
+		{
+			kind |= TARGET_NOTARGET;
+		}
+
+		targetCandidate_t candidate;
+		candidate.ent = ent;
+		candidate.kind = kind;
+		candidate.origin = Vec3::Load( ent->s.origin );
+		candidate.velocity = velocity;
+		candidate.reach = Math::Length( velocity ) * frameSeconds;
+
+		targetIndex.candidates[ team ].push_back( candidate );
+	} );
+
+	// components are visited in the order of their pools, turrets rely on the entity order for
+	// fair tie-breaks between targets
+	for ( std::vector<targetCandidate_t> &candidates : targetIndex.candidates )
+	{
+		std::sort( candidates.begin(), candidates.end(),
+		           []( const targetCandidate_t &a, const targetCandidate_t &b ) {
+			return a.ent.entity->s.number < b.ent.entity->s.number;
+		} );
+	}
+
+	targetIndex.time = level.time;
+}
+
+const std::vector<targetCandidate_t> &G_TargetIndex( team_t team )
+{
+	static const std::vector<targetCandidate_t> none;
+
+	if ( team <= TEAM_NONE || team >= NUM_TEAMS )
+	{
+		return none;
+	}
+
+	if ( targetIndex.time != level.time )
+	{
+		G_BuildTargetIndex();
+	}
+
+	return targetIndex.candidates[ team ];
+}
+
+void G_TargetIndexShutdown()
+{
+	targetIndex.time = -1;
+
+	for ( std::vector<targetCandidate_t> &candidates : targetIndex.candidates )
+	{
+		candidates.clear();
+	}
+}
@@ -0,0 +1,109 @@
+/*
+===========================================================================
+
+Unvanquished GPL Source Code
+Copyright (C) 2026 Unvanquished Developers
+
+This file is part of the Unvanquished GPL Source Code (Unvanquished Source Code).
+
+Unvanquished is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Unvanquished is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Unvanquished.  If not, see <http://www.gnu.org/licenses/>.
+
+===========================================================================
+*/
+
+// sg_targets.h -- per-frame index of the entities defensive buildables can attack
+
+#ifndef SG_TARGETS_H_
+#define SG_TARGETS_H_
+
+enum targetKind_t
+{
+	TARGET_PLAYERS    = 1,
+	TARGET_BUILDABLES = 2,
+
+	// also return the entities flagged FL_NOTARGET, for checks that aren't about attacking them
+	TARGET_NOTARGET   = 4,
+};
+
+struct targetCandidate_t
+{
+	GentityRef ent;
+	int        kind;     // TARGET_PLAYERS or TARGET_BUILDABLES, with TARGET_NOTARGET if flagged so
+	Vec3       origin;
+	Vec3       velocity;
+	float      reach;    // how far it can move until the end of the frame
+};
+
+/*
+ * The living players and buildables of a team, sorted by entity number. The
+ * index is built by the first query of a frame and shared by all the others,
+ * positions are the ones from that moment.
+ */
+const std::vector<targetCandidate_t> &G_TargetIndex( team_t team );
+
+void G_TargetIndexShutdown();
+
+/*
+ * Calls f for every candidate of the given kinds and team that may be within
+ * range of origin and, unless coneCos is -1 or less, within the cone around
+ * the unit vector axis whose half angle has the cosine coneCos.
+ * The index only filters coarsely with the reach of every candidate, callers
+ * check the exact conditions against the current entity.
+ */
+template<typename FuncType>
+void G_ForTargetsInCone( team_t team, int kinds, Vec3 origin, float range, Vec3 axis, float coneCos, FuncType f )
+{
+	for ( const targetCandidate_t &candidate : G_TargetIndex( team ) )
+	{
+		if ( !( candidate.kind & kinds & ( TARGET_PLAYERS | TARGET_BUILDABLES ) ) )
+		{
+			continue;
+		}
+
+		if ( ( candidate.kind & TARGET_NOTARGET ) && !( kinds & TARGET_NOTARGET ) )
+		{
+			continue;
+		}
+
+		// freed since the index was built
+		if ( !candidate.ent )
+		{
+			continue;
+		}
+
+		Vec3  toTarget = candidate.origin - origin;
+		float distance = Math::Length( toTarget );
+
+		if ( distance > range + candidate.reach )
+		{
+			continue;
+		}
+
+		// moving by reach changes both the projection on the axis and the distance by up to reach
+		if ( coneCos > -1.0f && Math::Dot( toTarget, axis ) < coneCos * distance - 2.0f * candidate.reach )
+		{
+			continue;
+		}
+
+		f( candidate );
+	}
+}
+
+template<typename FuncType>
+void G_ForTargetsInRange( team_t team, int kinds, Vec3 origin, float range, FuncType f )
+{
+	G_ForTargetsInCone( team, kinds, origin, range, Vec3( 0.0f, 0.0f, 0.0f ), -1.0f, f );
+}
+
+#endif // SG_TARGETS_H_
@@ -26,6 +26,7 @@ Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
 
 #include "sg_local.h"
 #include "Entities.h"
+#include "sg_cm_world.h"
 
 /*
 ================
@@ -329,18 +330,138 @@ void G_ChangeTeam( gentity_t *ent, team_t newTeam )
 	TeamplayInfoMessage( ent );
 }
 
+/*
+ * For every PVS cluster, the locations that are potentially visible from it, so
+ * that finding the location of a point doesn't need PVS tests against all of them.
+ * Whether doors between the point and a location are open is still checked when
+ * looking up, like trap_InPVS does.
+ */
+struct locationIndexEntry_t
+{
+	gentity_t *location;
+	int       area;
+};
+
+static struct
+{
+	bool                              built;
+	std::vector<int>                  clusterStart; // first entry of a cluster in entries
+	std::vector<locationIndexEntry_t> entries;
+	std::vector<gentity_t *>          unclustered; // locations in solid, tested as before
+} locationIndex;
+
+/*
+==================
+G_BuildLocationIndex
+
+Called once the map entities are spawned.
+==================
+*/
+void G_BuildLocationIndex()
+{
+	struct location_t
+	{
+		gentity_t *ent;
+		int       cluster;
+		int       area;
+	};
+
+	std::vector<location_t> locations;
+	int numClusters = G_CM_NumClusters();
+
+	locationIndex.clusterStart.assign( numClusters + 1, 0 );
+	locationIndex.entries.clear();
+	locationIndex.unclustered.clear();
+
+	for ( gentity_t *eloc = level.locationHead; eloc; eloc = eloc->nextPathSegment )
+	{
+		int area;
+		int cluster = G_CM_PointCluster( eloc->r.currentOrigin, &area );
+
+		if ( cluster < 0 || cluster >= numClusters )
+		{
+			locationIndex.unclustered.push_back( eloc );
+			continue;
+		}
+
+		locations.push_back( { eloc, cluster, area } );
+	}
+
+	for ( int cluster = 0; cluster < numClusters; cluster++ )
+	{
+		locationIndex.clusterStart[ cluster ] = locationIndex.entries.size();
+
+		for ( const location_t &location : locations )
+		{
+			if ( G_CM_ClusterInPVS( cluster, location.cluster ) )
+			{
+				locationIndex.entries.push_back( { location.ent, location.area } );
+			}
+		}
+	}
+
+	locationIndex.clusterStart[ numClusters ] = locationIndex.entries.size();
+	locationIndex.built = true;
+
+	Log::Debug( "location index: %d locations, %d clusters, %d entries",
+	            ( int ) ( locations.size() + locationIndex.unclustered.size() ), numClusters,
+	            ( int ) locationIndex.entries.size() );
+}
+
 /**
  * @todo Move out of sg_team.c as it is not team-specific.
  */
 gentity_t *GetCloseLocationEntity( gentity_t *ent )
 {
-	gentity_t *eloc, *best;
+	gentity_t *best;
 	float     bestlen, len;
+	int       area, cluster;
 
 	best = nullptr;
 	bestlen = 3.0f * 8192.0f * 8192.0f;
 
-	for ( eloc = level.locationHead; eloc; eloc = eloc->nextPathSegment )
+	cluster = G_CM_PointCluster( ent->r.currentOrigin, &area );
+
+	if ( locationIndex.built && cluster >= 0 && cluster + 1 < ( int ) locationIndex.clusterStart.size() )
+	{
+		for ( int i = locationIndex.clusterStart[ cluster ]; i < locationIndex.clusterStart[ cluster + 1 ]; i++ )
+		{
+			const locationIndexEntry_t &entry = locationIndex.entries[ i ];
+
+			len = DistanceSquared( ent->r.currentOrigin, entry.location->r.currentOrigin );
+
+			if ( len > bestlen )
+			{
+				continue;
+			}
+
+			// a door blocks sight
+			if ( !G_CM_AreasConnected( area, entry.area ) )
+			{
+				continue;
+			}
+
+			bestlen = len;
+			best = entry.location;
+		}
+
+		for ( gentity_t *eloc : locationIndex.unclustered )
+		{
+			len = DistanceSquared( ent->r.currentOrigin, eloc->r.currentOrigin );
+
+			if ( len > bestlen || !trap_InPVS( ent->r.currentOrigin, eloc->r.currentOrigin ) )
+			{
+				continue;
+			}
+
+			bestlen = len;
+			best = eloc;
+		}
+
+		return best;
+	}
+
+	for ( gentity_t *eloc = level.locationHead; eloc; eloc = eloc->nextPathSegment )
 	{
 		len = DistanceSquared( ent->r.currentOrigin, eloc->r.currentOrigin );
 
@@ -363,26 +484,54 @@ gentity_t *GetCloseLocationEntity( gentity_t *ent )
 
 /*---------------------------------------------------------------------------*/
 
+enum teamInfoField_t
+{
+	TEAMINFO_LOCATION,
+	TEAMINFO_HEALTH,
+	TEAMINFO_WEAPONCLASS,
+	TEAMINFO_CREDIT,
+	TEAMINFO_UPGRADE,
+
+	NUM_TEAMINFO_FIELDS
+};
+
+/*
+ * What every client was last sent about its teammates, so that only the
+ * fields that changed need to be sent again.
+ */
+struct teamInfoSent_t
+{
+	int  syncTime; // pers.teamInfo when the fields were sent, if it changed everything is resent
+	int  team;
+	bool known[ MAX_CLIENTS ];
+	int  enterTime[ MAX_CLIENTS ]; // to notice a new player in the slot
+	int  fields[ MAX_CLIENTS ][ NUM_TEAMINFO_FIELDS ];
+};
+
+static teamInfoSent_t teamInfoSent[ MAX_CLIENTS ];
+
 /*
 ==================
 TeamplayInfoMessage
 
 Format:
-  clientNum location health weapon upgrade
+  tinfod followed by, for every teammate whose information changed,
+  clientNum fieldMask and the value of every field set in the mask
 
 ==================
 */
 void TeamplayInfoMessage( gentity_t *ent )
 {
-	char      entry[ 24 ];
-	char      string[ ( MAX_CLIENTS - 1 ) * ( sizeof( entry ) - 1 ) + 1 ];
-	int       i, j;
-	int       team, stringlength;
-	gentity_t *player;
-	gclient_t *cl;
-	upgrade_t upgrade = UP_NONE;
-	int       curWeaponClass = WP_NONE; // sends weapon for humans, class for aliens
-	int       health = 0;
+	char           entry[ 32 ];
+	char           string[ ( MAX_CLIENTS - 1 ) * ( sizeof( entry ) - 1 ) + 1 ];
+	int            i, j;
+	int            team, stringlength;
+	gentity_t      *player;
+	gclient_t      *cl;
+	upgrade_t      upgrade = UP_NONE;
+	int            curWeaponClass = WP_NONE; // sends weapon for humans, class for aliens
+	int            health = 0;
+	teamInfoSent_t *sent;
 
 	if ( !g_allowTeamOverlay.integer )
 	{
@@ -410,6 +559,16 @@ void TeamplayInfoMessage( gentity_t *ent )
 		team = ent->client->pers.team;
 	}
 
+	// forget what was sent when the client asks for everything again
+	sent = &teamInfoSent[ ent - g_entities ];
+
+	if ( sent->syncTime != ent->client->pers.teamInfo || sent->team != team )
+	{
+		memset( sent->known, 0, sizeof( sent->known ) );
+		sent->syncTime = ent->client->pers.teamInfo;
+		sent->team = team;
+	}
+
 	string[ 0 ] = '\0';
 	stringlength = 0;
 
@@ -468,41 +627,60 @@ void TeamplayInfoMessage( gentity_t *ent )
 			health = static_cast<int>( std::ceil( Entities::HealthOf(player) ) );
 		}
 
-		if( team == TEAM_ALIENS ) // aliens don't have upgrades
+		int fields[ NUM_TEAMINFO_FIELDS ];
+		fields[ TEAMINFO_LOCATION ]    = cl->pers.location;
+		fields[ TEAMINFO_HEALTH ]      = health;
+		fields[ TEAMINFO_WEAPONCLASS ] = curWeaponClass;
+		fields[ TEAMINFO_CREDIT ]      = cl->pers.credit;
+		fields[ TEAMINFO_UPGRADE ]     = upgrade;
+
+		// aliens don't have upgrades
+		int numFields = ( team == TEAM_ALIENS ) ? TEAMINFO_UPGRADE : NUM_TEAMINFO_FIELDS;
+		int mask = 0;
+
+		for ( j = 0; j < numFields; j++ )
 		{
-			Com_sprintf( entry, sizeof( entry ), " %i %i %i %i %i", i,
-						 cl->pers.location,
-			             health,
-						 curWeaponClass,
-						 cl->pers.credit );
+			if ( !sent->known[ i ] || sent->enterTime[ i ] != cl->pers.enterTime ||
+			     sent->fields[ i ][ j ] != fields[ j ] )
+			{
+				mask |= 1 << j;
+			}
 		}
-		else
+
+		if ( !mask )
 		{
-			Com_sprintf( entry, sizeof( entry ), " %i %i %i %i %i %i", i,
-			             cl->pers.location,
-			             health,
-			             curWeaponClass,
-			             cl->pers.credit,
-			             upgrade );
+			continue;
 		}
 
+		int entryLength = Com_sprintf( entry, sizeof( entry ), " %i %i", i, mask );
 
-		j = strlen( entry );
+		for ( j = 0; j < numFields; j++ )
+		{
+			if ( mask & ( 1 << j ) )
+			{
+				entryLength += Com_sprintf( entry + entryLength, sizeof( entry ) - entryLength, " %i", fields[ j ] );
+			}
+		}
 
 		// this should not happen if entry and string sizes are correct
-		if ( stringlength + j >= (int) sizeof( string ) )
+		if ( stringlength + entryLength >= (int) sizeof( string ) )
 		{
 			break;
 		}
 
 		strcpy( string + stringlength, entry );
-		stringlength += j;
+		stringlength += entryLength;
+
+		sent->known[ i ] = true;
+		sent->enterTime[ i ] = cl->pers.enterTime;
+		memcpy( sent->fields[ i ], fields, sizeof( fields ) );
 	}
 
 	if( string[ 0 ] )
 	{
-		trap_SendServerCommand( ent - g_entities, va( "tinfo%s", string ) );
+		trap_SendServerCommand( ent - g_entities, va( "tinfod%s", string ) );
 		ent->client->pers.teamInfo = level.time;
+		sent->syncTime = level.time;
 	}
 }
 
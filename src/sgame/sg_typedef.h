@@ -39,11 +39,15 @@ typedef struct variatingTime_s     variatingTime_t;
 typedef struct gentityConditions_s gentityConditions_t;
 typedef struct gentityConfig_s     gentityConfig_t;
 typedef struct entityClass_s       entityClass_t;
+typedef struct gentityScript_s     gentityScript_t;
+typedef struct damageCredit_s      damageCredit_t;
+typedef struct damageLedger_s      damageLedger_t;
 typedef struct gentity_s           gentity_t;
 typedef struct clientSession_s     clientSession_t;
 typedef struct namelog_s           namelog_t;
 typedef struct clientPersistant_s  clientPersistant_t;
 typedef struct unlagged_s          unlagged_t;
+typedef struct unlaggedFrame_s     unlaggedFrame_t;
 typedef struct gclient_s           gclient_t;
 typedef struct damageRegion_s      damageRegion_t;
 typedef struct spawnQueue_s        spawnQueue_t;
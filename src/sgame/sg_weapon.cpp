@@ -221,7 +221,9 @@ bool G_RefillFuel( gentity_t *self, bool triggerEvent )
  */
 bool G_FindAmmo( gentity_t *self )
 {
-	gentity_t *neighbor = nullptr;
+	gentity_t      *neighbors[ MAX_GENTITIES ];
+	int            numNeighbors;
+	entityFilter_t filter;
 	bool  foundSource = false;
 
 	// don't search for a source if refilling isn't possible
@@ -231,10 +233,16 @@ bool G_FindAmmo( gentity_t *self )
 	}
 
 	// search for ammo source
-	while ( ( neighbor = G_IterateEntitiesWithinRadius( neighbor, self->s.origin, ENTITY_BUY_RANGE ) ) )
+	filter.eType = entityType_t::ET_BUILDABLE;
+	filter.team = G_Team( self );
+	numNeighbors = G_EntitiesWithinRadius( self->s.origin, ENTITY_BUY_RANGE, neighbors, MAX_GENTITIES, filter );
+
+	for ( int i = 0; i < numNeighbors; i++ )
 	{
+		gentity_t *neighbor = neighbors[ i ];
+
 		// only friendly, living and powered buildables provide ammo
-		if ( neighbor->s.eType != entityType_t::ET_BUILDABLE || !G_OnSameTeam( self, neighbor ) ||
+		if ( !G_OnSameTeam( self, neighbor ) ||
 		     !neighbor->spawned || !neighbor->powered || Entities::IsDead( neighbor ) )
 		{
 			continue;
@@ -269,7 +277,9 @@ bool G_FindAmmo( gentity_t *self )
  */
 bool G_FindFuel( gentity_t *self )
 {
-	gentity_t *neighbor = nullptr;
+	gentity_t      *neighbors[ MAX_GENTITIES ];
+	int            numNeighbors;
+	entityFilter_t filter;
 	bool  foundSource = false;
 
 	if ( !self || !self->client )
@@ -278,10 +288,16 @@ bool G_FindFuel( gentity_t *self )
 	}
 
 	// search for fuel source
-	while ( ( neighbor = G_IterateEntitiesWithinRadius( neighbor, self->s.origin, ENTITY_BUY_RANGE ) ) )
+	filter.eType = entityType_t::ET_BUILDABLE;
+	filter.team = G_Team( self );
+	numNeighbors = G_EntitiesWithinRadius( self->s.origin, ENTITY_BUY_RANGE, neighbors, MAX_GENTITIES, filter );
+
+	for ( int i = 0; i < numNeighbors; i++ )
 	{
+		gentity_t *neighbor = neighbors[ i ];
+
 		// only friendly, living and powered buildables provide fuel
-		if ( neighbor->s.eType != entityType_t::ET_BUILDABLE || !G_OnSameTeam( self, neighbor ) ||
+		if ( !G_OnSameTeam( self, neighbor ) ||
 		     !neighbor->spawned || !neighbor->powered || Entities::IsDead( neighbor ) )
 		{
 			continue;
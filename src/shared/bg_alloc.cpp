@@ -24,22 +24,366 @@ Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
 ===========================================================================
 */
 
+// bg_alloc.cpp -- memory of the game logic
+//
+// Allocations are served from one of two arenas. Between BG_BeginMapArena and
+// BG_ReleaseMapArena, that is while a map is running in the sgame, they go to
+// the map arena, otherwise to the persistent one. Small allocations are carved
+// from chunks in power of two size classes and recycled through free lists.
+// Releasing the map arena takes back all of its memory in one step and keeps
+// the chunks for the next map, so memory use stays flat over map changes.
+// Allocations are counted by call site for BG_PrintAllocStats.
+
 #include "engine/qcommon/q_shared.h"
 #include "bg_public.h"
 
-void *BG_Alloc( size_t size )
+#include <unordered_map>
+#include <vector>
+
+#define ALLOC_MIN_CLASS_SHIFT 4                     // 16 bytes
+#define ALLOC_NUM_CLASSES     8                     // up to 2048 bytes
+#define ALLOC_LARGE           ALLOC_NUM_CLASSES     // sizeClass of allocations made with malloc
+#define ALLOC_CHUNK_SIZE      ( 64 * 1024 )
+#define ALLOC_MAGIC           0x4241u               // "AB"
+
+struct allocHeader_t
+{
+	allocHeader_t *next;       // in the free list of the class, or in the list of large allocations
+	allocHeader_t *prev;       // large allocations only
+	uint32_t      size;        // as requested
+	uint16_t      site;
+	uint8_t       arena;
+	uint8_t       sizeClass;
+	uint32_t      generation;  // of the arena when allocated
+	uint16_t      magic;
+};
+
+// keeps the memory handed out aligned as malloc would
+#define ALLOC_HEADER_SIZE ( ( sizeof( allocHeader_t ) + 15 ) & ~( size_t ) 15 )
+
+struct allocArena_t
+{
+	const char          *name;
+	std::vector<byte *> chunks;
+	size_t              currentChunk; // the one blocks are carved from
+	size_t              chunkUsed;    // of the current chunk
+	allocHeader_t       *freeLists[ ALLOC_NUM_CLASSES ];
+	allocHeader_t       *large;
+	uint32_t            generation;   // increased on every release
+
+	size_t              liveBytes;
+	size_t              peakBytes;
+	int                 liveCount;
+};
+
+struct allocSite_t
+{
+	const char *file;
+	int        line;
+	int        allocs; // since the start
+	int        liveCount[ NUM_ALLOC_ARENAS ];
+	size_t     liveBytes[ NUM_ALLOC_ARENAS ];
+	size_t     peakBytes;
+};
+
+static allocArena_t arenas[ NUM_ALLOC_ARENAS ] = { { "persistent" }, { "map" } };
+static allocArena_t *currentArena = &arenas[ ALLOC_ARENA_PERSISTENT ];
+
+static std::vector<allocSite_t>                allocSites;
+static std::unordered_map<uint64_t, uint16_t> allocSiteIndex;
+
+static int BG_AllocSite( const char *file, int line )
+{
+	// the file names are string literals, so their addresses identify them
+	uint64_t key = ( uint64_t )( uintptr_t ) file ^ ( ( uint64_t ) line << 48 );
+	auto     it = allocSiteIndex.find( key );
+
+	if ( it != allocSiteIndex.end() )
+	{
+		return it->second;
+	}
+
+	allocSite_t site{};
+	site.file = file;
+	site.line = line;
+
+	allocSites.push_back( site );
+	allocSiteIndex[ key ] = allocSites.size() - 1;
+
+	return allocSites.size() - 1;
+}
+
+static int BG_AllocSizeClass( size_t size )
+{
+	for ( int sizeClass = 0; sizeClass < ALLOC_NUM_CLASSES; sizeClass++ )
+	{
+		if ( size <= ( size_t ) 1 << ( sizeClass + ALLOC_MIN_CLASS_SHIFT ) )
+		{
+			return sizeClass;
+		}
+	}
+
+	return ALLOC_LARGE;
+}
+
+static allocHeader_t *BG_AllocFromChunk( allocArena_t &arena, int sizeClass )
+{
+	size_t blockSize = ALLOC_HEADER_SIZE + ( ( size_t ) 1 << ( sizeClass + ALLOC_MIN_CLASS_SHIFT ) );
+
+	if ( arena.chunkUsed + blockSize > ALLOC_CHUNK_SIZE )
+	{
+		// chunks kept from the previous map are reused before new ones are added
+		arena.currentChunk++;
+		arena.chunkUsed = 0;
+	}
+
+	if ( arena.currentChunk == arena.chunks.size() )
+	{
+		byte *chunk = ( byte * ) malloc( ALLOC_CHUNK_SIZE );
+
+		if ( !chunk )
+		{
+			return nullptr;
+		}
+
+		arena.chunks.push_back( chunk );
+	}
+
+	allocHeader_t *header = ( allocHeader_t * )( arena.chunks[ arena.currentChunk ] + arena.chunkUsed );
+	arena.chunkUsed += blockSize;
+
+	return header;
+}
+
+/*
+================
+BG_AllocAt
+
+Allocates zeroed memory from the current arena, use BG_Alloc.
+================
+*/
+void *BG_AllocAt( size_t size, const char *file, int line )
 {
-	void *ptr = malloc( size );
+	allocArena_t  &arena = *currentArena;
+	int           sizeClass = BG_AllocSizeClass( size );
+	allocHeader_t *header;
 
-	if ( ptr )
+	if ( sizeClass == ALLOC_LARGE )
 	{
-		memset( ptr, 0, size );
+		header = ( allocHeader_t * ) malloc( ALLOC_HEADER_SIZE + size );
+
+		if ( !header )
+		{
+			return nullptr;
+		}
+
+		header->prev = nullptr;
+		header->next = arena.large;
+
+		if ( arena.large )
+		{
+			arena.large->prev = header;
+		}
+
+		arena.large = header;
+	}
+	else if ( arena.freeLists[ sizeClass ] )
+	{
+		header = arena.freeLists[ sizeClass ];
+		arena.freeLists[ sizeClass ] = header->next;
+	}
+	else
+	{
+		header = BG_AllocFromChunk( arena, sizeClass );
+
+		if ( !header )
+		{
+			return nullptr;
+		}
 	}
 
+	allocSite_t &site = allocSites[ BG_AllocSite( file, line ) ];
+
+	header->size = size;
+	header->site = &site - allocSites.data();
+	header->arena = currentArena - arenas;
+	header->sizeClass = sizeClass;
+	header->generation = arena.generation;
+	header->magic = ALLOC_MAGIC;
+
+	site.allocs++;
+	site.liveCount[ header->arena ]++;
+	site.liveBytes[ header->arena ] += size;
+	site.peakBytes = std::max( site.peakBytes, site.liveBytes[ header->arena ] );
+
+	arena.liveCount++;
+	arena.liveBytes += size;
+	arena.peakBytes = std::max( arena.peakBytes, arena.liveBytes );
+
+	void *ptr = ( byte * ) header + ALLOC_HEADER_SIZE;
+	memset( ptr, 0, size );
+
 	return ptr;
 }
 
 void BG_Free( void *ptr )
 {
-	free( ptr );
+	if ( !ptr )
+	{
+		return;
+	}
+
+	allocHeader_t *header = ( allocHeader_t * )( ( byte * ) ptr - ALLOC_HEADER_SIZE );
+
+	if ( header->magic != ALLOC_MAGIC || header->arena >= NUM_ALLOC_ARENAS )
+	{
+		Log::Warn( "BG_Free: %p was not allocated with BG_Alloc or is freed twice", ptr );
+		return;
+	}
+
+	allocArena_t &arena = arenas[ header->arena ];
+
+	// the memory was reclaimed with the rest of the map arena already; this only
+	// catches the mistake as long as the memory wasn't handed out again
+	if ( header->generation != arena.generation )
+	{
+		Log::Warn( "BG_Free: %p was allocated at %s:%d on a previous map", ptr,
+		           allocSites[ header->site ].file, allocSites[ header->site ].line );
+		return;
+	}
+
+	allocSite_t &site = allocSites[ header->site ];
+
+	site.liveCount[ header->arena ]--;
+	site.liveBytes[ header->arena ] -= header->size;
+	arena.liveCount--;
+	arena.liveBytes -= header->size;
+
+	header->magic = 0;
+
+	if ( header->sizeClass == ALLOC_LARGE )
+	{
+		if ( header->prev )
+		{
+			header->prev->next = header->next;
+		}
+		else
+		{
+			arena.large = header->next;
+		}
+
+		if ( header->next )
+		{
+			header->next->prev = header->prev;
+		}
+
+		free( header );
+		return;
+	}
+
+	header->next = arena.freeLists[ header->sizeClass ];
+	arena.freeLists[ header->sizeClass ] = header;
+}
+
+/*
+================
+BG_BeginMapArena
+
+Directs the following allocations to the map arena.
+================
+*/
+void BG_BeginMapArena()
+{
+	currentArena = &arenas[ ALLOC_ARENA_MAP ];
+}
+
+/*
+================
+BG_ReleaseMapArena
+
+Frees everything allocated in the map arena at once, whether it was freed
+already or not, and directs the following allocations to the persistent
+arena again. Nothing allocated in the map arena may be used afterwards.
+================
+*/
+void BG_ReleaseMapArena()
+{
+	allocArena_t &arena = arenas[ ALLOC_ARENA_MAP ];
+
+	if ( arena.liveCount )
+	{
+		Log::Debug( "releasing %d allocations of %zu bytes left in the map arena",
+		            arena.liveCount, arena.liveBytes );
+	}
+
+	for ( allocHeader_t *header = arena.large, *next; header; header = next )
+	{
+		next = header->next;
+		free( header );
+	}
+
+	arena.large = nullptr;
+
+	// keep the chunks for the next map
+	memset( arena.freeLists, 0, sizeof( arena.freeLists ) );
+	arena.currentChunk = 0;
+	arena.chunkUsed = 0;
+
+	arena.generation++;
+	arena.liveCount = 0;
+	arena.liveBytes = 0;
+
+	for ( allocSite_t &site : allocSites )
+	{
+		site.liveCount[ ALLOC_ARENA_MAP ] = 0;
+		site.liveBytes[ ALLOC_ARENA_MAP ] = 0;
+	}
+
+	currentArena = &arenas[ ALLOC_ARENA_PERSISTENT ];
+}
+
+/*
+================
+BG_PrintAllocStats
+
+Prints the memory use of the arenas and the call sites holding the most memory.
+================
+*/
+void BG_PrintAllocStats()
+{
+	Log::Notice( "%-12s %8s %10s %10s %8s", "arena", "live", "bytes", "peak", "chunks" );
+
+	for ( const allocArena_t &arena : arenas )
+	{
+		Log::Notice( "%-12s %8d %10zu %10zu %8zu", arena.name, arena.liveCount, arena.liveBytes,
+		             arena.peakBytes, arena.chunks.size() );
+	}
+
+	std::vector<const allocSite_t *> sites;
+
+	for ( const allocSite_t &site : allocSites )
+	{
+		sites.push_back( &site );
+	}
+
+	auto liveBytes = []( const allocSite_t *site )
+	{
+		return site->liveBytes[ ALLOC_ARENA_PERSISTENT ] + site->liveBytes[ ALLOC_ARENA_MAP ];
+	};
+
+	std::sort( sites.begin(), sites.end(), [ & ]( const allocSite_t *a, const allocSite_t *b )
+	{
+		return liveBytes( a ) > liveBytes( b );
+	} );
+
+	Log::Notice( "%-40s %8s %8s %10s %10s", "call site", "allocs", "live", "bytes", "peak" );
+
+	for ( size_t i = 0; i < sites.size() && i < 32; i++ )
+	{
+		const allocSite_t *site = sites[ i ];
+
+		Log::Notice( "%-40s %8d %8d %10zu %10zu", Str::Format( "%s:%d", site->file, site->line ), site->allocs,
+		             site->liveCount[ ALLOC_ARENA_PERSISTENT ] + site->liveCount[ ALLOC_ARENA_MAP ],
+		             liveBytes( site ), site->peakBytes );
+	}
 }
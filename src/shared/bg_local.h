@@ -61,9 +61,6 @@ struct pml_t
 	int      previous_waterlevel;
 };
 
-extern  pmove_t *pm;
-extern  pml_t   pml;
-
 // movement parameters
 #define pm_duckScale         (0.25f)
 #define pm_swimScale         (0.50f)
@@ -78,13 +75,80 @@ extern  pml_t   pml;
 extern  int     c_pmove;
 
 void            PM_ClipVelocity( const vec3_t in, const vec3_t normal, vec3_t out );
-void            PM_AddTouchEnt( int entityNum );
-void            PM_AddEvent( int newEvent );
 
-bool        PM_SlideMove( bool gravity );
-void            PM_StepEvent( const vec3_t from, const vec3_t to, const vec3_t normal );
-bool        PM_StepSlideMove( bool gravity, bool predictive );
-bool        PM_PredictStepMove();
+// the working state of a player move, so that moves don't share anything
+// and can be run side by side, see Pmove
+struct pmoveContext_t
+{
+	pmove_t *pm;
+	pml_t   pml;
+
+	explicit pmoveContext_t( pmove_t *pmove ) : pm( pmove ), pml() {}
+
+	// runs a single step of at most 66 msec up to pm->cmd.serverTime
+	void  MoveSingle();
+
+	// bg_pmove.cpp
+	void  PM_AddEvent( int newEvent );
+	void  PM_AddTouchEnt( int entityNum );
+	void  PM_StartTorsoAnim( int anim );
+	void  PM_StartWeaponAnim( int anim );
+	void  PM_StartLegsAnim( int anim );
+	void  PM_ContinueLegsAnim( int anim );
+	void  PM_ContinueTorsoAnim( int anim );
+	void  PM_ContinueWeaponAnim( int anim );
+	void  PM_ForceLegsAnim( int anim );
+	void  PM_Friction();
+	void  PM_Accelerate( const vec3_t wishdir, float wishspeed, float accel );
+	float PM_CmdScale( usercmd_t *cmd, bool zFlight );
+	void  PM_SetMovementDir();
+	void  PM_CheckCharge();
+	void  PM_CheckWaterPounce();
+	void  PM_PlayJumpingAnimation();
+	bool  PM_CheckPounce();
+	bool  PM_CheckWallJump();
+	bool  PM_CheckWallRun();
+	bool  PM_CheckJetpack();
+	bool  PM_CheckJetpackRestoreFuel();
+	void  PM_LandJetpack( bool force );
+	bool  PM_CheckJump();
+	bool  PM_CheckWaterJump();
+	void  PM_WaterJumpMove();
+	void  PM_WaterMove();
+	void  PM_GhostMove( bool noclip );
+	void  PM_AirMove();
+	void  PM_ClimbMove();
+	void  PM_WalkMove();
+	void  PM_LadderMove();
+	void  PM_CheckLadder();
+	void  PM_DeadMove();
+	int   PM_FootstepForSurface();
+	void  PM_Land();
+	void  PM_CrashLand();
+	int   PM_CorrectAllSolid( trace_t *trace );
+	void  PM_GroundTraceMissed();
+	void  PM_GroundClimbTrace();
+	void  PM_GroundTrace();
+	void  PM_SetWaterLevel();
+	void  PM_SetViewheight();
+	void  PM_CheckDuck();
+	void  PM_Footsteps();
+	void  PM_WaterEvents();
+	void  PM_BeginWeaponChange( int weapon );
+	void  PM_FinishWeaponChange();
+	void  HandleDeconstructButton();
+	void  PM_TorsoAnimation();
+	void  PM_Weapon();
+	void  PM_Animate();
+	void  PM_DropTimers();
+	void  PM_HumanStaminaEffects();
+
+	// bg_slidemove.cpp
+	bool  PM_SlideMove( bool gravity );
+	void  PM_StepEvent( const vec3_t from, const vec3_t to, const vec3_t normal );
+	bool  PM_StepSlideMove( bool gravity, bool predictive );
+	bool  PM_PredictStepMove();
+};
 
 //==================================================================
 #endif /* BG_LOCAL_H_ */
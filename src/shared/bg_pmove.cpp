@@ -31,9 +31,6 @@ Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
 #include "bg_public.h"
 #include "bg_local.h"
 
-pmove_t *pm;
-pml_t   pml;
-
 int     c_pmove = 0;
 
 /*
@@ -42,7 +39,7 @@ PM_AddEvent
 
 ===============
 */
-void PM_AddEvent( int newEvent )
+void pmoveContext_t::PM_AddEvent( int newEvent )
 {
 	BG_AddPredictableEventToPlayerstate( newEvent, 0, pm->ps );
 }
@@ -52,7 +49,7 @@ void PM_AddEvent( int newEvent )
 PM_AddTouchEnt
 ===============
 */
-void PM_AddTouchEnt( int entityNum )
+void pmoveContext_t::PM_AddTouchEnt( int entityNum )
 {
 	int i;
 
@@ -85,7 +82,7 @@ void PM_AddTouchEnt( int entityNum )
 PM_StartTorsoAnim
 ===================
 */
-void PM_StartTorsoAnim( int anim )
+void pmoveContext_t::PM_StartTorsoAnim( int anim )
 {
 	if ( PM_Paralyzed( pm->ps->pm_type ) )
 	{
@@ -100,7 +97,7 @@ void PM_StartTorsoAnim( int anim )
 PM_StartWeaponAnim
 ===================
 */
-static void PM_StartWeaponAnim( int anim )
+void pmoveContext_t::PM_StartWeaponAnim( int anim )
 {
 	if ( PM_Paralyzed( pm->ps->pm_type ) )
 	{
@@ -115,7 +112,7 @@ static void PM_StartWeaponAnim( int anim )
 PM_StartLegsAnim
 ===================
 */
-static void PM_StartLegsAnim( int anim )
+void pmoveContext_t::PM_StartLegsAnim( int anim )
 {
 	if ( PM_Paralyzed( pm->ps->pm_type ) )
 	{
@@ -146,7 +143,7 @@ static void PM_StartLegsAnim( int anim )
 PM_ContinueLegsAnim
 ===================
 */
-static void PM_ContinueLegsAnim( int anim )
+void pmoveContext_t::PM_ContinueLegsAnim( int anim )
 {
 	if ( ( pm->ps->legsAnim & ~ANIM_TOGGLEBIT ) == anim )
 	{
@@ -177,7 +174,7 @@ static void PM_ContinueLegsAnim( int anim )
 PM_ContinueTorsoAnim
 ===================
 */
-static void PM_ContinueTorsoAnim( int anim )
+void pmoveContext_t::PM_ContinueTorsoAnim( int anim )
 {
 	if ( ( pm->ps->torsoAnim & ~ANIM_TOGGLEBIT ) == anim )
 	{
@@ -197,7 +194,7 @@ static void PM_ContinueTorsoAnim( int anim )
 PM_ContinueWeaponAnim
 ===================
 */
-static void PM_ContinueWeaponAnim( int anim )
+void pmoveContext_t::PM_ContinueWeaponAnim( int anim )
 {
 	if ( ( pm->ps->weaponAnim & ~ANIM_TOGGLEBIT ) == anim )
 	{
@@ -212,7 +209,7 @@ static void PM_ContinueWeaponAnim( int anim )
 PM_ForceLegsAnim
 ===================
 */
-static void PM_ForceLegsAnim( int anim )
+void pmoveContext_t::PM_ForceLegsAnim( int anim )
 {
 	//legsTimer is clamped too tightly for nonsegmented models
 	if ( !( pm->ps->persistant[ PERS_STATE ] & PS_NONSEGMODEL ) )
@@ -247,7 +244,7 @@ PM_Friction
 Handles both ground friction and water friction
 ==================
 */
-static void PM_Friction()
+void pmoveContext_t::PM_Friction()
 {
 	vec3_t vec;
 	float  *vel;
@@ -326,7 +323,7 @@ PM_Accelerate
 Handles user intended acceleration
 ==============
 */
-static void PM_Accelerate( const vec3_t wishdir, float wishspeed, float accel )
+void pmoveContext_t::PM_Accelerate( const vec3_t wishdir, float wishspeed, float accel )
 {
 #if 1
 	// q2 style
@@ -384,7 +381,7 @@ This allows the clients to use axial -127 to 127 values for all directions
 without getting a sqrt(2) distortion in speed.
 ============
 */
-static float PM_CmdScale( usercmd_t *cmd, bool zFlight )
+float pmoveContext_t::PM_CmdScale( usercmd_t *cmd, bool zFlight )
 {
 	int   max;
 	float total;
@@ -564,7 +561,7 @@ PM_SetMovementDir
 Determine the rotation of the legs relative to the facing dir
 ================
 */
-static void PM_SetMovementDir()
+void pmoveContext_t::PM_SetMovementDir()
 {
 	if ( pm->cmd.forwardmove || pm->cmd.rightmove )
 	{
@@ -622,7 +619,7 @@ static void PM_SetMovementDir()
 PM_CheckCharge
 =============
 */
-static void PM_CheckCharge()
+void pmoveContext_t::PM_CheckCharge()
 {
 	if ( pm->ps->weapon != WP_ALEVEL4 )
 	{
@@ -651,7 +648,7 @@ static void PM_CheckCharge()
 PM_CheckWaterPounce
 =============
 */
-static void PM_CheckWaterPounce()
+void pmoveContext_t::PM_CheckWaterPounce()
 {
 	// Check for valid class
 	switch ( pm->ps->weapon )
@@ -685,7 +682,7 @@ static void PM_CheckWaterPounce()
 PM_PlayJumpingAnimation
 =============
 */
-static void PM_PlayJumpingAnimation()
+void pmoveContext_t::PM_PlayJumpingAnimation()
 {
 	if ( pm->cmd.forwardmove >= 0 )
 	{
@@ -720,7 +717,7 @@ static void PM_PlayJumpingAnimation()
 PM_CheckPounce
 =============
 */
-static bool PM_CheckPounce()
+bool pmoveContext_t::PM_CheckPounce()
 {
 	const static vec3_t up = { 0.0f, 0.0f, 1.0f };
 
@@ -1051,7 +1048,7 @@ static bool PM_CheckPounce()
 PM_CheckWallJump
 =============
 */
-static bool PM_CheckWallJump()
+bool pmoveContext_t::PM_CheckWallJump()
 {
 	vec3_t  dir, forward, right, movedir, point;
 	float   normalFraction = 1.5f;
@@ -1180,7 +1177,7 @@ static bool PM_CheckWallJump()
 PM_CheckWallRun
 =============
 */
-static bool PM_CheckWallRun()
+bool pmoveContext_t::PM_CheckWallRun()
 {
 	float jumpMag;
 	Vec3 dir, origin, velocity, normal;
@@ -1254,7 +1251,7 @@ static bool PM_CheckWallRun()
  * @brief PM_CheckJetpack
  * @return true if and only if thrust was applied
  */
-static bool PM_CheckJetpack()
+bool pmoveContext_t::PM_CheckJetpack()
 {
 	static const vec3_t thrustDir = { 0.0f, 0.0f, 1.0f };
 	int                 sideVelocity;
@@ -1405,7 +1402,7 @@ static bool PM_CheckJetpack()
  * @brief Restores jetpack fuel
  * @return true if and only if fuel has been restored
  */
-static bool PM_CheckJetpackRestoreFuel()
+bool pmoveContext_t::PM_CheckJetpackRestoreFuel()
 {
 	// don't restore fuel when full or jetpack active
 	if ( pm->ps->stats[ STAT_FUEL ] == JETPACK_FUEL_MAX ||
@@ -1427,7 +1424,7 @@ static bool PM_CheckJetpackRestoreFuel()
 /**
  * @brief Disables the jetpack. Without force, the call can get ignored based on previous velocity.
  */
-static void PM_LandJetpack( bool force )
+void pmoveContext_t::PM_LandJetpack( bool force )
 {
 	float angle, sideVelocity;
 
@@ -1491,7 +1488,7 @@ static void PM_LandJetpack( bool force )
 	}
 }
 
-static bool PM_CheckJump()
+bool pmoveContext_t::PM_CheckJump()
 {
 	vec3_t   normal;
 	int      staminaJumpCost;
@@ -1617,7 +1614,7 @@ static bool PM_CheckJump()
 	return true;
 }
 
-static bool PM_CheckWaterJump()
+bool pmoveContext_t::PM_CheckWaterJump()
 {
 	vec3_t spot;
 	int    cont;
@@ -1675,7 +1672,7 @@ PM_WaterJumpMove
 Flying out of the water
 ===================
 */
-static void PM_WaterJumpMove()
+void pmoveContext_t::PM_WaterJumpMove()
 {
 	// waterjump has no control, but falls
 
@@ -1697,7 +1694,7 @@ PM_WaterMove
 
 ===================
 */
-static void PM_WaterMove()
+void pmoveContext_t::PM_WaterMove()
 {
 	int    i;
 	vec3_t wishvel;
@@ -1780,7 +1777,7 @@ static void PM_WaterMove()
 /**
  * @brief Used for both free spectating and noclip mode
  */
-static void PM_GhostMove( bool noclip )
+void pmoveContext_t::PM_GhostMove( bool noclip )
 {
 	int    i;
 	float  scale, wishspeed;
@@ -1819,7 +1816,7 @@ PM_AirMove
 
 ===================
 */
-static void PM_AirMove()
+void pmoveContext_t::PM_AirMove()
 {
 	int       i;
 	vec3_t    wishvel;
@@ -1882,7 +1879,7 @@ PM_ClimbMove
 
 ===================
 */
-static void PM_ClimbMove()
+void pmoveContext_t::PM_ClimbMove()
 {
 	int       i;
 	vec3_t    wishvel;
@@ -2011,7 +2008,7 @@ PM_WalkMove
 
 ===================
 */
-static void PM_WalkMove()
+void pmoveContext_t::PM_WalkMove()
 {
 	int       i;
 	vec3_t    wishvel;
@@ -2168,7 +2165,7 @@ PM_LadderMove
 Basically a rip of PM_WaterMove with a few changes
 ===================
 */
-static void PM_LadderMove()
+void pmoveContext_t::PM_LadderMove()
 {
 	int    i;
 	vec3_t wishvel;
@@ -2215,7 +2212,7 @@ PM_CheckLadder
 Check to see if the player is on a ladder or not
 =============
 */
-static void PM_CheckLadder()
+void pmoveContext_t::PM_CheckLadder()
 {
 	vec3_t  forward, end;
 	trace_t trace;
@@ -2250,7 +2247,7 @@ static void PM_CheckLadder()
 PM_DeadMove
 ==============
 */
-static void PM_DeadMove()
+void pmoveContext_t::PM_DeadMove()
 {
 	float forward;
 
@@ -2284,7 +2281,7 @@ PM_FootstepForSurface
 Returns an event number appropriate for the groundsurface
 ================
 */
-static int PM_FootstepForSurface()
+int pmoveContext_t::PM_FootstepForSurface()
 {
 	if ( pm->ps->stats[ STAT_STATE ] & SS_CREEPSLOWED )
 	{
@@ -2311,7 +2308,7 @@ PM_Land
 Play landing animation
 =================
 */
-static void PM_Land()
+void pmoveContext_t::PM_Land()
 {
 	PM_LandJetpack( false ); // don't force a stop, sometimes we can push off with a jump
 
@@ -2359,7 +2356,7 @@ PM_CrashLand
 Check for hard landings that generate sound events
 =================
 */
-static void PM_CrashLand()
+void pmoveContext_t::PM_CrashLand()
 {
 	float delta;
 	float dist;
@@ -2454,7 +2451,7 @@ static void PM_CrashLand()
 PM_CorrectAllSolid
 =============
 */
-static int PM_CorrectAllSolid( trace_t *trace )
+int pmoveContext_t::PM_CorrectAllSolid( trace_t *trace )
 {
 	int    i, j, k;
 	vec3_t point;
@@ -2507,7 +2504,7 @@ PM_GroundTraceMissed
 The ground trace didn't hit a surface, so we are in freefall
 =============
 */
-static void PM_GroundTraceMissed()
+void pmoveContext_t::PM_GroundTraceMissed()
 {
 	trace_t trace;
 	vec3_t  point;
@@ -2588,7 +2585,7 @@ enum {
 	NUM_GCT_ATP
 };
 
-static void PM_GroundClimbTrace()
+void pmoveContext_t::PM_GroundClimbTrace()
 {
 	vec3_t      surfNormal, moveDir, lookDir, point, velocityDir;
 	vec3_t      toAngles, surfAngles;
@@ -2994,7 +2991,7 @@ static void PM_GroundClimbTrace()
 PM_GroundTrace
 =============
 */
-static void PM_GroundTrace()
+void pmoveContext_t::PM_GroundTrace()
 {
 	vec3_t  point;
 	trace_t trace;
@@ -3237,7 +3234,7 @@ static void PM_GroundTrace()
 PM_SetWaterLevel  FIXME: avoid this twice?  certainly if not moving
 =============
 */
-static void PM_SetWaterLevel()
+void pmoveContext_t::PM_SetWaterLevel()
 {
 	vec3_t point;
 	int    cont;
@@ -3284,7 +3281,7 @@ static void PM_SetWaterLevel()
 PM_SetViewheight
 ==============
 */
-static void PM_SetViewheight()
+void pmoveContext_t::PM_SetViewheight()
 {
 	pm->ps->viewheight = ( pm->ps->pm_flags & PMF_DUCKED )
 	                     ? BG_ClassModelConfig( pm->ps->stats[ STAT_CLASS ] )->crouchViewheight
@@ -3298,7 +3295,7 @@ PM_CheckDuck
 Sets mins and maxs, and calls PM_SetViewheight
 ==============
 */
-static void PM_CheckDuck()
+void pmoveContext_t::PM_CheckDuck()
 {
 	trace_t trace;
 	vec3_t  PCmins, PCmaxs, PCcmaxs;
@@ -3362,7 +3359,7 @@ static void PM_CheckDuck()
 PM_Footsteps
 ===============
 */
-static void PM_Footsteps()
+void pmoveContext_t::PM_Footsteps()
 {
 	float    bobmove;
 	int      old;
@@ -3645,7 +3642,7 @@ PM_WaterEvents
 Generate sound events for entering and leaving water
 ==============
 */
-static void PM_WaterEvents()
+void pmoveContext_t::PM_WaterEvents()
 {
 	// FIXME?
 	//
@@ -3686,7 +3683,7 @@ static void PM_WaterEvents()
 PM_BeginWeaponChange
 ===============
 */
-static void PM_BeginWeaponChange( int weapon )
+void pmoveContext_t::PM_BeginWeaponChange( int weapon )
 {
 	if ( weapon <= WP_NONE || weapon >= WP_NUM_WEAPONS )
 	{
@@ -3735,7 +3732,7 @@ static void PM_BeginWeaponChange( int weapon )
 PM_FinishWeaponChange
 ===============
 */
-static void PM_FinishWeaponChange()
+void pmoveContext_t::PM_FinishWeaponChange()
 {
 	int weapon;
 
@@ -3763,7 +3760,7 @@ static void PM_FinishWeaponChange()
 	}
 }
 
-static void HandleDeconstructButton()
+void pmoveContext_t::HandleDeconstructButton()
 {
 	if ( usercmdButtonPressed( pm->cmd.buttons, BUTTON_ATTACK ) ||
 	     ( pm->ps->weaponstate != WEAPON_READY && pm->ps->weaponstate != WEAPON_FIRING ) )
@@ -3826,7 +3823,7 @@ PM_TorsoAnimation
 
 ==============
 */
-static void PM_TorsoAnimation()
+void pmoveContext_t::PM_TorsoAnimation()
 {
 	if ( pm->ps->weaponstate == WEAPON_READY )
 	{
@@ -3846,7 +3843,7 @@ PM_Weapon
 Generates weapon events and modifies the weapon counter
 ==============
 */
-static void PM_Weapon()
+void pmoveContext_t::PM_Weapon()
 {
 	int      addTime = 200; //default addTime - should never be used
 	bool attack1 = usercmdButtonPressed( pm->cmd.buttons, BUTTON_ATTACK );
@@ -4482,7 +4479,7 @@ static void PM_Weapon()
 PM_Animate
 ================
 */
-static void PM_Animate()
+void pmoveContext_t::PM_Animate()
 {
 	if ( PM_Paralyzed( pm->ps->pm_type ) )
 	{
@@ -4560,7 +4557,7 @@ static void PM_Animate()
 PM_DropTimers
 ================
 */
-static void PM_DropTimers()
+void pmoveContext_t::PM_DropTimers()
 {
 	// drop misc timing counter
 	if ( pm->ps->pm_time )
@@ -4732,7 +4729,7 @@ void PM_UpdateViewAngles( playerState_t *ps, const usercmd_t *cmd )
 	}
 }
 
-static void PM_HumanStaminaEffects()
+void pmoveContext_t::PM_HumanStaminaEffects()
 {
 	const classAttributes_t *ca;
 	int      *stats;
@@ -4790,14 +4787,12 @@ static void PM_HumanStaminaEffects()
 
 /*
 ================
-PmoveSingle
+pmoveContext_t::MoveSingle
 
 ================
 */
-void PmoveSingle( pmove_t *pmove )
+void pmoveContext_t::MoveSingle()
 {
-	pm = pmove;
-
 	// this counter lets us debug movement problems with a journal
 	// by setting a conditional breakpoint for the previous frame
 	c_pmove++;
@@ -4865,16 +4860,16 @@ void PmoveSingle( pmove_t *pmove )
 	// if talk button is down, disallow all other input
 	// this is to prevent any possible intercept proxy from
 	// adding fake talk balloons
-	if ( usercmdButtonPressed( pmove->cmd.buttons, BUTTON_TALK ) )
+	if ( usercmdButtonPressed( pm->cmd.buttons, BUTTON_TALK ) )
 	{
-		usercmdClearButtons( pmove->cmd.buttons );
-		usercmdPressButton( pmove->cmd.buttons, BUTTON_TALK );
-		pmove->cmd.forwardmove = 0;
-		pmove->cmd.rightmove = 0;
+		usercmdClearButtons( pm->cmd.buttons );
+		usercmdPressButton( pm->cmd.buttons, BUTTON_TALK );
+		pm->cmd.forwardmove = 0;
+		pm->cmd.rightmove = 0;
 
-		if ( pmove->cmd.upmove > 0 )
+		if ( pm->cmd.upmove > 0 )
 		{
-			pmove->cmd.upmove = 0;
+			pm->cmd.upmove = 0;
 		}
 	}
 
@@ -4882,7 +4877,7 @@ void PmoveSingle( pmove_t *pmove )
 	memset( &pml, 0, sizeof( pml ) );
 
 	// determine the time
-	pml.msec = pmove->cmd.serverTime - pm->ps->commandTime;
+	pml.msec = pm->cmd.serverTime - pm->ps->commandTime;
 
 	if ( pml.msec < 1 )
 	{
@@ -4893,7 +4888,7 @@ void PmoveSingle( pmove_t *pmove )
 		pml.msec = 200;
 	}
 
-	pm->ps->commandTime = pmove->cmd.serverTime;
+	pm->ps->commandTime = pm->cmd.serverTime;
 
 	// save old org in case we get stuck
 	VectorCopy( pm->ps->origin, pml.previous_origin );
@@ -4955,7 +4950,7 @@ void PmoveSingle( pmove_t *pmove )
 
 	// set watertype, and waterlevel
 	PM_SetWaterLevel();
-	pml.previous_waterlevel = pmove->waterlevel;
+	pml.previous_waterlevel = pm->waterlevel;
 
 	// set mins, maxs, and viewheight
 	PM_CheckDuck();
@@ -5032,7 +5027,7 @@ void PmoveSingle( pmove_t *pmove )
 	// entering / leaving water splashes
 	PM_WaterEvents();
 
-	if ( !pmove->pmove_accurate )
+	if ( !pm->pmove_accurate )
 	{
 		// snap some parts of playerstate to save network bandwidth
 		SnapVector( pm->ps->velocity );
@@ -5048,7 +5043,8 @@ Can be called by either the server or the client
 */
 void Pmove( pmove_t *pmove )
 {
-	int finalTime;
+	pmoveContext_t context( pmove );
+	int            finalTime;
 
 	finalTime = pmove->cmd.serverTime;
 
@@ -5088,6 +5084,6 @@ void Pmove( pmove_t *pmove )
 		}
 
 		pmove->cmd.serverTime = pmove->ps->commandTime + msec;
-		PmoveSingle( pmove );
+		context.MoveSingle();
 	}
 }
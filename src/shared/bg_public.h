@@ -1581,8 +1581,20 @@ void     CG_UpdateUnlockables( playerState_t *ps );
 #define MASK_SHOT        ( CONTENTS_SOLID | CONTENTS_BODY )
 #define MASK_ENTITY      ( CONTENTS_MOVER )
 
-void     *BG_Alloc( size_t size );
+enum allocArenaNum_t
+{
+  ALLOC_ARENA_PERSISTENT,
+  ALLOC_ARENA_MAP,
+
+  NUM_ALLOC_ARENAS
+};
+
+void     *BG_AllocAt( size_t size, const char *file, int line );
+#define  BG_Alloc( size ) BG_AllocAt( ( size ), __FILE__, __LINE__ )
 void     BG_Free( void *ptr );
+void     BG_BeginMapArena();
+void     BG_ReleaseMapArena();
+void     BG_PrintAllocStats();
 
 void     BG_EvaluateTrajectory( const trajectory_t *tr, int atTime, vec3_t result );
 void     BG_EvaluateTrajectoryDelta( const trajectory_t *tr, int atTime, vec3_t result );
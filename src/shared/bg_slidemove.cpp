@@ -46,7 +46,7 @@ Returns true if the velocity was clipped in some way
 ==================
 */
 #define MAX_CLIP_PLANES 5
-bool  PM_SlideMove( bool gravity )
+bool pmoveContext_t::PM_SlideMove( bool gravity )
 {
 	int     bumpcount, numbumps;
 	vec3_t  dir;
@@ -265,7 +265,7 @@ bool  PM_SlideMove( bool gravity )
 PM_StepEvent
 ==================
 */
-void PM_StepEvent( const vec3_t from, const vec3_t to, const vec3_t normal )
+void pmoveContext_t::PM_StepEvent( const vec3_t from, const vec3_t to, const vec3_t normal )
 {
 	float  size;
 	vec3_t delta, dNormal;
@@ -334,7 +334,7 @@ void PM_StepEvent( const vec3_t from, const vec3_t to, const vec3_t normal )
 PM_StepSlideMove
 ==================
 */
-bool PM_StepSlideMove( bool gravity, bool predictive )
+bool pmoveContext_t::PM_StepSlideMove( bool gravity, bool predictive )
 {
 	vec3_t   start_o, start_v;
 	vec3_t   down_o, down_v;
@@ -455,7 +455,7 @@ bool PM_StepSlideMove( bool gravity, bool predictive )
 PM_PredictStepMove
 ==================
 */
-bool PM_PredictStepMove()
+bool pmoveContext_t::PM_PredictStepMove()
 {
 	vec3_t   velocity, origin;
 	float    impactSpeed;